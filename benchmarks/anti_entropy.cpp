@@ -0,0 +1,107 @@
+// Merkle anti-entropy: seeds the stand-in server with a multi-year history,
+// lets both sides drift on a few days and reports what Reconcile costs.
+//
+//   anti_entropy [--years N] [--tasks N] [--sessions N] [--drift N]
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+#include "bench_util.h"
+#include "storage/serialization.h"
+#include "sync/sync_client.h"
+#include "sync_server/stand_in_server.h"
+
+namespace {
+
+typedef std::chrono::system_clock::time_point TimePoint;
+
+void AddSession(MothershipTask& task, TimePoint start, std::chrono::seconds length) {
+    SingleTimeframe timeframe;
+    timeframe.Originate();
+    timeframe.startTime = start;
+    timeframe.endTime = start + length;
+    timeframe.started = false;
+    timeframe.finished = true;
+    timeframe.clock = MothershipClockTick();
+    int index = task.timeFrames.empty() ? 0 : task.timeFrames.rbegin()->first + 1;
+    task.timeFrames.emplace_hint(task.timeFrames.end(), index, timeframe);
+    task.currentTimeframe = index;
+}
+
+void Report(const char* label, const MothershipReconcileStats& stats, double seconds) {
+    std::printf("%-18s %zu requests, %zu B sent, %zu B received, %zu leaves, %.2f ms, %s\n",
+                label, stats.requests, stats.bytesSent, stats.bytesReceived, stats.leavesPulled,
+                seconds * 1000.0, stats.inSync ? "in sync" : "DIVERGED");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int years = static_cast<int>(ArgInt(argc, argv, "--years", 3));
+    int taskCount = static_cast<int>(ArgInt(argc, argv, "--tasks", 40));
+    int sessionsPerDay = static_cast<int>(ArgInt(argc, argv, "--sessions", 6));
+    int drift = static_cast<int>(ArgInt(argc, argv, "--drift", 5));
+
+    std::mt19937 rng(7);
+    MothershipData local;
+    for (int t = 0; t < taskCount; ++t) {
+        local.AddTask("task-" + std::to_string(t), MothershipColor(t % 8), false);
+    }
+    TimePoint begin = std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now()) -
+                      std::chrono::days(365 * years);
+    size_t sessions = 0;
+    for (int day = 0; day < 365 * years; ++day) {
+        for (int s = 0; s < sessionsPerDay; ++s) {
+            auto& task = std::next(local.tasks.begin(), rng() % taskCount)->second;
+            AddSession(task, begin + std::chrono::days(day) + std::chrono::minutes(30 + 90 * s),
+                       std::chrono::seconds(600 + rng() % 3600));
+            ++sessions;
+        }
+    }
+
+    MothershipStandInServer server;
+    if (!server.Start()) {
+        std::fprintf(stderr, "cannot start stand-in server\n");
+        return 1;
+    }
+    server.SeedReplica(local);
+
+    std::string cachePath = (std::filesystem::temp_directory_path() / "mothership_bench_cache.json").string();
+    MothershipSyncClient client(server.BaseUrl(), cachePath);
+    std::printf("history: %d years, %d tasks, %zu sessions\n", years, taskCount, sessions);
+
+    MothershipReconcileStats stats;
+    BenchTimer timer;
+    bool ok = client.Reconcile(local, &stats);
+    Report("identical:", stats, timer.Seconds());
+
+    // Drift: new sessions locally and, on other days, on the server.
+    MothershipData remote = local;
+    for (int i = 0; i < drift; ++i) {
+        auto& mine = std::next(local.tasks.begin(), rng() % taskCount)->second;
+        AddSession(mine, begin + std::chrono::days(rng() % (365 * years)) + std::chrono::hours(20),
+                   std::chrono::seconds(900));
+        auto& theirs = std::next(remote.tasks.begin(), rng() % taskCount)->second;
+        AddSession(theirs, begin + std::chrono::days(rng() % (365 * years)) + std::chrono::hours(21),
+                   std::chrono::seconds(900));
+    }
+    server.SeedReplica(remote);
+
+    stats = MothershipReconcileStats();
+    timer = BenchTimer();
+    ok = client.Reconcile(local, &stats) && ok;
+    Report("drifted:", stats, timer.Seconds());
+
+    stats = MothershipReconcileStats();
+    timer = BenchTimer();
+    ok = client.Reconcile(local, &stats) && ok;
+    Report("after reconcile:", stats, timer.Seconds());
+
+    size_t fullBytes = DataToJson(local).dump().size();
+    std::printf("full resync would transfer about %zu B each way\n", fullBytes);
+
+    server.Stop();
+    std::remove(cachePath.c_str());
+    return ok && stats.inSync ? 0 : 1;
+}
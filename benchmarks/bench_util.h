@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Shared helpers for the benchmark executables.
+
+// Benchmarks create tasks and sessions the way the app does; a device id
+// of their own keeps them off the user's device_id file. Set through the
+// environment, which is only read on first use, so static initialization
+// order does not matter.
+inline const bool benchmarkDevice = setenv("MOTHERSHIP_DEVICE_ID", "benchmark", 0) == 0;
+
+inline double Percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t rank = static_cast<size_t>(p / 100.0 * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+// Returns the value following `--name` on the command line, or `fallback`.
+inline const char* ArgValue(int argc, char** argv, const char* name, const char* fallback) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (!std::strcmp(argv[i], name)) {
+            return argv[i + 1];
+        }
+    }
+    return fallback;
+}
+
+inline long long ArgInt(int argc, char** argv, const char* name, long long fallback) {
+    const char* value = ArgValue(argc, argv, name, nullptr);
+    return value ? std::atoll(value) : fallback;
+}
+
+inline double ArgDouble(int argc, char** argv, const char* name, double fallback) {
+    const char* value = ArgValue(argc, argv, name, nullptr);
+    return value ? std::atof(value) : fallback;
+}
+
+class BenchTimer {
+public:
+    BenchTimer() : start(std::chrono::steady_clock::now()) {
+
+    }
+    inline double Seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
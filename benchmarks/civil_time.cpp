@@ -0,0 +1,153 @@
+// Local-time bucketing: splits intervals at local midnights and keys each
+// piece by local day and ISO week, once with localtime_r/mktime and once
+// with the civil-date engine and its offset table, and checks both produce
+// the same pieces. Month starts are compared against mktime too.
+//
+//   civil_time [--intervals N] [--zone Europe/Berlin]
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <random>
+
+#include "bench_util.h"
+#include "reports/civil_time.h"
+
+namespace {
+
+struct Interval {
+    int64_t start;
+    int64_t end;
+};
+
+// Order-sensitive digest of the pieces.
+struct Digest {
+    uint64_t hash = 1469598103934665603ULL;
+    size_t pieces = 0;
+
+    inline void Add(int64_t day, int64_t week, int64_t length) {
+        for (int64_t value : {day, week, length}) {
+            hash = (hash ^ static_cast<uint64_t>(value)) * 1099511628211ULL;
+        }
+        pieces += 1;
+    }
+    inline bool operator==(const Digest&) const = default;
+};
+
+int64_t LibcIsoWeek(const std::tm& local) {
+    auto weeksIn = [](int year) {
+        auto dec31 = [](int y) { return (y + y / 4 - y / 100 + y / 400) % 7; };
+        return 52 + ((dec31(year) == 4 || dec31(year - 1) == 3) ? 1 : 0);
+    };
+    int year = local.tm_year + 1900;
+    int weekday = local.tm_wday == 0 ? 7 : local.tm_wday;
+    int week = (local.tm_yday + 1 - weekday + 10) / 7;
+    if (week < 1) {
+        year -= 1;
+        week = weeksIn(year);
+    } else if (week > weeksIn(year)) {
+        year += 1;
+        week = 1;
+    }
+    return static_cast<int64_t>(year) * 100 + week;
+}
+
+Digest BucketLibc(const std::vector<Interval>& intervals) {
+    Digest digest;
+    for (const Interval& interval : intervals) {
+        for (int64_t s = interval.start; s < interval.end;) {
+            std::time_t t = static_cast<std::time_t>(s);
+            std::tm local{};
+            localtime_r(&t, &local);
+            int64_t day = static_cast<int64_t>(local.tm_year + 1900) * 10000 + (local.tm_mon + 1) * 100 + local.tm_mday;
+            int64_t week = LibcIsoWeek(local);
+            local.tm_mday += 1;
+            local.tm_hour = 0;
+            local.tm_min = 0;
+            local.tm_sec = 0;
+            local.tm_isdst = -1;
+            int64_t piece = std::min<int64_t>(interval.end, std::mktime(&local));
+            digest.Add(day, week, piece - s);
+            s = piece;
+        }
+    }
+    return digest;
+}
+
+Digest BucketEngine(const std::vector<Interval>& intervals, const MothershipTimeZone& zone) {
+    Digest digest;
+    for (const Interval& interval : intervals) {
+        for (int64_t s = interval.start; s < interval.end;) {
+            int64_t days = MothershipFloorDiv(zone.ToLocal(s), 86400);
+            MothershipCivilDate date = MothershipCivilFromDays(days);
+            int64_t day = static_cast<int64_t>(date.year) * 10000 + date.month * 100 + date.day;
+            int64_t thursday = days - MothershipIsoWeekday(days) + 3;
+            int year = MothershipCivilFromDays(thursday).year;
+            int64_t week = static_cast<int64_t>(year) * 100 + (thursday - MothershipDaysFromCivil(year, 1, 1)) / 7 + 1;
+            int64_t piece = std::min(interval.end, zone.ToUtc((days + 1) * 86400));
+            digest.Add(day, week, piece - s);
+            s = piece;
+        }
+    }
+    return digest;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = static_cast<size_t>(ArgInt(argc, argv, "--intervals", 1000000));
+    if (const char* zoneName = ArgValue(argc, argv, "--zone", nullptr)) {
+        setenv("TZ", zoneName, 1);
+    }
+    tzset();
+
+    BenchTimer timer;
+    const MothershipTimeZone& zone = MothershipTimeZone::Local();
+    double buildSeconds = timer.Seconds();
+
+    // Sessions of up to 30 hours between 1990 and 2060, so many cross
+    // midnight and daylight saving changes.
+    std::mt19937_64 rng(17);
+    int64_t begin = MothershipDaysFromCivil(1990, 1, 1) * 86400;
+    int64_t span = MothershipDaysFromCivil(2060, 1, 1) * 86400 - begin;
+    std::vector<Interval> intervals(count);
+    for (Interval& interval : intervals) {
+        interval.start = begin + static_cast<int64_t>(rng() % static_cast<uint64_t>(span));
+        interval.end = interval.start + 1 + static_cast<int64_t>(rng() % (30 * 3600));
+    }
+
+    timer = BenchTimer();
+    Digest libc = BucketLibc(intervals);
+    double libcSeconds = timer.Seconds();
+    timer = BenchTimer();
+    Digest engine = BucketEngine(intervals, zone);
+    double engineSeconds = timer.Seconds();
+
+    size_t monthMismatches = 0;
+    for (size_t i = 0; i < std::min<size_t>(count, 100000); ++i) {
+        std::time_t t = static_cast<std::time_t>(intervals[i].start);
+        std::tm local{};
+        localtime_r(&t, &local);
+        local.tm_mon += 1;
+        local.tm_mday = 1;
+        local.tm_hour = 0;
+        local.tm_min = 0;
+        local.tm_sec = 0;
+        local.tm_isdst = -1;
+        MothershipTimePoint expected = std::chrono::system_clock::from_time_t(std::mktime(&local));
+        if (zone.MonthStart(MothershipTimePoint(std::chrono::seconds(t)), 1) != expected) {
+            ++monthMismatches;
+        }
+    }
+
+    double perMillion = 1e6 / static_cast<double>(count);
+    std::printf("zone %s: %zu offset changes, table built in %.2f ms\n", std::getenv("TZ") ? std::getenv("TZ") : "(local)",
+                zone.Transitions(), buildSeconds * 1000.0);
+    std::printf("%zu intervals, %zu day pieces\n", count, engine.pieces);
+    std::printf("libc:   %.1f ms per million intervals\n", libcSeconds * 1000.0 * perMillion);
+    std::printf("engine: %.1f ms per million intervals (%.1fx)\n", engineSeconds * 1000.0 * perMillion,
+                libcSeconds / engineSeconds);
+    bool ok = libc == engine && monthMismatches == 0;
+    std::printf("%s, %zu month start mismatches\n", libc == engine ? "pieces match" : "PIECES DIFFER", monthMismatches);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+// Interval clipping kernels: clips a large [start, end) array against
+// random windows with each kernel the CPU supports, reports intervals per
+// second and checks every vector result against the scalar one.
+//
+//   interval_kernels [--intervals N] [--windows N]
+
+#include <cstdio>
+#include <random>
+
+#include "bench_util.h"
+#include "reports/interval_kernels.h"
+
+int main(int argc, char** argv) {
+    size_t intervals = static_cast<size_t>(ArgInt(argc, argv, "--intervals", 4000000));
+    size_t windows = static_cast<size_t>(ArgInt(argc, argv, "--windows", 20));
+
+    // Microsecond timestamps over ten years, mostly disjoint sessions.
+    std::mt19937_64 rng(5);
+    std::vector<int64_t> starts(intervals);
+    std::vector<int64_t> ends(intervals);
+    int64_t at = 1500000000LL * 1000000;
+    for (size_t i = 0; i < intervals; ++i) {
+        at += static_cast<int64_t>(rng() % 3600) * 1000000;
+        starts[i] = at;
+        at += static_cast<int64_t>(60 + rng() % 5400) * 1000000;
+        ends[i] = at;
+    }
+    std::vector<std::pair<int64_t, int64_t>> queries;
+    for (size_t w = 0; w < windows; ++w) {
+        int64_t from = starts[0] + static_cast<int64_t>(rng() % static_cast<uint64_t>(at - starts[0]));
+        queries.emplace_back(from, from + static_cast<int64_t>(rng() % static_cast<uint64_t>(at - from + 1)));
+    }
+
+    std::vector<MothershipIntervalStats> expected;
+    bool ok = true;
+    for (int isa = KernelScalar; isa <= MothershipBestKernel(); ++isa) {
+        MothershipKernelIsa kernel = static_cast<MothershipKernelIsa>(isa);
+        std::vector<MothershipIntervalStats> results;
+        BenchTimer timer;
+        for (auto& [from, to] : queries) {
+            results.push_back(MothershipClipIntervals(kernel, starts.data(), ends.data(), intervals, from, to));
+        }
+        double seconds = timer.Seconds();
+        size_t mismatches = 0;
+        if (kernel == KernelScalar) {
+            expected = results;
+        } else {
+            for (size_t w = 0; w < results.size(); ++w) {
+                mismatches += results[w] == expected[w] ? 0 : 1;
+            }
+        }
+        ok = ok && mismatches == 0;
+        std::printf("%-7s %8.1f M intervals/s  %zu mismatches\n", MothershipKernelName(kernel),
+                    intervals * windows / seconds / 1e6, mismatches);
+    }
+    std::printf("dispatch: %s\n", MothershipKernelName(MothershipBestKernel()));
+    return ok ? 0 : 1;
+}
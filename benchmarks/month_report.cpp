@@ -0,0 +1,98 @@
+// Month report: builds the report for a generated history on 1, 2, 4 ...
+// threads and checks every result against the single-threaded one.
+//
+//   month_report [--tasks N] [--sessions N] [--threads N] [--rounds N]
+
+#include <cstdio>
+#include <random>
+
+#include "bench_util.h"
+#include "reports/month_report.h"
+
+namespace {
+
+typedef std::chrono::system_clock::time_point TimePoint;
+
+void AddSession(MothershipTask& task, TimePoint start, std::chrono::seconds length) {
+    SingleTimeframe timeframe;
+    timeframe.startTime = start;
+    timeframe.endTime = start + length;
+    timeframe.started = false;
+    timeframe.finished = true;
+    int index = task.timeFrames.empty() ? 0 : task.timeFrames.rbegin()->first + 1;
+    task.timeFrames.emplace_hint(task.timeFrames.end(), index, timeframe);
+    task.currentTimeframe = index;
+}
+
+bool SameReport(const MothershipMonthReport& a, const MothershipMonthReport& b) {
+    if (a.tasks.size() != b.tasks.size() || a.total != b.total || a.days != b.days) {
+        return false;
+    }
+    for (size_t i = 0; i < a.tasks.size(); ++i) {
+        const MothershipTaskMonth& x = a.tasks[i];
+        const MothershipTaskMonth& y = b.tasks[i];
+        if (x.title != y.title || x.total != y.total || x.sessions != y.sessions || x.longest != y.longest ||
+            x.days != y.days) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int taskCount = static_cast<int>(ArgInt(argc, argv, "--tasks", 2000));
+    int sessions = static_cast<int>(ArgInt(argc, argv, "--sessions", 2000));
+    unsigned maxThreads = static_cast<unsigned>(ArgInt(argc, argv, "--threads", std::thread::hardware_concurrency()));
+    int rounds = static_cast<int>(ArgInt(argc, argv, "--rounds", 3));
+
+    // Two years of history per task, reported on the month before last.
+    std::mt19937 rng(3);
+    MothershipData data;
+    TimePoint now = std::chrono::system_clock::now();
+    for (int t = 0; t < taskCount; ++t) {
+        std::string title = "task-" + std::to_string(t);
+        data.AddTask(title, MothershipColor(t % 8), false);
+        MothershipTask& task = data.tasks.at(title);
+        TimePoint begin = now - std::chrono::days(730);
+        long spacing = 730L * 86400 / sessions;
+        for (int s = 0; s < sessions; ++s) {
+            TimePoint at = begin + std::chrono::seconds(s * spacing + rng() % (spacing / 2));
+            AddSession(task, at, std::chrono::seconds(std::min<long>(spacing / 2, 300 + rng() % 3600)));
+        }
+    }
+    data.InvalidateIndex();
+    std::time_t t = std::chrono::system_clock::to_time_t(now - std::chrono::days(45));
+    std::tm local{};
+    localtime_r(&t, &local);
+    int year = local.tm_year + 1900;
+    int month = local.tm_mon + 1;
+    std::printf("%d tasks x %d sessions, report for %04d-%02d\n", taskCount, sessions, year, month);
+
+    // The first build also builds every task's range index.
+    MothershipMonthReport expected;
+    BenchTimer timer;
+    MothershipBuildMonthReport(data, year, month, nullptr, expected);
+    std::printf("cold, 1 thread:  %.2f ms\n", timer.Seconds() * 1000.0);
+
+    bool ok = true;
+    double serial = 0.0;
+    for (unsigned threads = 1; threads <= std::max(1u, maxThreads); threads *= 2) {
+        MothershipWorkPool pool(threads);
+        std::vector<double> times;
+        for (int round = 0; round < rounds; ++round) {
+            MothershipMonthReport report;
+            timer = BenchTimer();
+            MothershipBuildMonthReport(data, year, month, &pool, report);
+            times.push_back(timer.Seconds());
+            ok = ok && SameReport(report, expected);
+        }
+        double best = Percentile(times, 0.0);
+        serial = threads == 1 ? best : serial;
+        std::printf("%3u threads:     %.2f ms (%.1fx)\n", threads, best * 1000.0, serial / best);
+    }
+    std::printf("%zu tasks with time, %.1f h total, %s\n", expected.tasks.size(), MothershipSeconds(expected.total) / 3600.0,
+                ok ? "identical across thread counts" : "RESULTS DIFFER");
+    return ok ? 0 : 1;
+}
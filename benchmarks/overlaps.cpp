@@ -0,0 +1,113 @@
+// Overlap sweep: finds exclusive and overlapped time across many tasks
+// that often run at once, and checks the totals against a plain sort of
+// all session endpoints.
+//
+//   overlaps [--tasks N] [--sessions N] [--days N]
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "bench_util.h"
+#include "reports/overlap.h"
+
+namespace {
+
+typedef std::chrono::system_clock::time_point TimePoint;
+
+void AddSession(MothershipTask& task, TimePoint start, std::chrono::seconds length) {
+    SingleTimeframe timeframe;
+    timeframe.startTime = start;
+    timeframe.endTime = start + length;
+    timeframe.started = false;
+    timeframe.finished = true;
+    int index = task.timeFrames.empty() ? 0 : task.timeFrames.rbegin()->first + 1;
+    task.timeFrames.emplace_hint(task.timeFrames.end(), index, timeframe);
+    task.currentTimeframe = index;
+}
+
+// Covered and overlapped wall-clock time from every endpoint sorted at once.
+void Reference(MothershipData& data, TimePoint from, TimePoint to, double& covered, double& overlapped) {
+    std::vector<std::pair<TimePoint, int>> events;
+    for (auto& [title, task] : data.tasks) {
+        for (auto& [index, timeframe] : task.timeFrames) {
+            TimePoint start = std::max(from, timeframe.startTime);
+            TimePoint end = std::min(to, timeframe.endTime);
+            if (start < end) {
+                events.emplace_back(start, 1);
+                events.emplace_back(end, -1);
+            }
+        }
+    }
+    std::sort(events.begin(), events.end());
+    covered = 0.0;
+    overlapped = 0.0;
+    int open = 0;
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (i > 0) {
+            double length = std::chrono::duration<double>(events[i].first - events[i - 1].first).count();
+            covered += open > 0 ? length : 0.0;
+            overlapped += open > 1 ? length : 0.0;
+        }
+        open += events[i].second;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int taskCount = static_cast<int>(ArgInt(argc, argv, "--tasks", 200));
+    int sessions = static_cast<int>(ArgInt(argc, argv, "--sessions", 2000));
+    int days = static_cast<int>(ArgInt(argc, argv, "--days", 365));
+
+    // Sessions of one task never overlap each other, so the reference's
+    // count of open sessions is a count of running tasks.
+    std::mt19937 rng(13);
+    MothershipData data;
+    TimePoint end = std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now());
+    TimePoint begin = end - std::chrono::days(days);
+    long spacing = days * 86400L / sessions;
+    for (int t = 0; t < taskCount; ++t) {
+        std::string title = "task-" + std::to_string(t);
+        data.AddTask(title, MothershipColor(t % 8), false);
+        MothershipTask& task = data.tasks.at(title);
+        for (int s = 0; s < sessions; ++s) {
+            TimePoint at = begin + std::chrono::seconds(s * spacing + rng() % (spacing / 2));
+            AddSession(task, at, std::chrono::seconds(std::min<long>(spacing / 2, 60 + rng() % 5400)));
+        }
+    }
+    data.InvalidateIndex();
+    size_t total = static_cast<size_t>(taskCount) * sessions;
+
+    MothershipOverlapReport report;
+    MothershipFindOverlaps(data, begin, end, report);
+    BenchTimer timer;
+    MothershipFindOverlaps(data, begin, end, report);
+    double sweepSeconds = timer.Seconds();
+
+    double covered, overlapped;
+    timer = BenchTimer();
+    Reference(data, begin, end, covered, overlapped);
+    double referenceSeconds = timer.Seconds();
+
+    double exclusive = 0.0;
+    double attributed = 0.0;
+    for (const MothershipOverlapTime& time : report.totals) {
+        exclusive += MothershipSeconds(time.exclusive);
+        attributed += time.attributed.count();
+    }
+    double coveredSeconds = MothershipSeconds(report.covered);
+    double overlappedSeconds = MothershipSeconds(report.overlapped);
+    bool ok = std::fabs(coveredSeconds - covered) < 1e-3 && std::fabs(overlappedSeconds - overlapped) < 1e-3 &&
+              std::fabs(attributed - covered) < 1e-3 * std::max(1.0, covered / 3600.0) &&
+              std::fabs(coveredSeconds - overlappedSeconds - exclusive) < 1e-3;
+
+    std::printf("%d tasks x %d sessions over %d days\n", taskCount, sessions, days);
+    std::printf("sweep:     %.2f ms (%.1f M sessions/s), %zu days\n", sweepSeconds * 1000.0,
+                total / sweepSeconds / 1e6, report.days.size());
+    std::printf("reference: %.2f ms\n", referenceSeconds * 1000.0);
+    std::printf("tracked %.1f h, wall-clock %.1f h, overlapped %.1f h\n", report.tracked.count() / 3600.0,
+                coveredSeconds / 3600.0, overlappedSeconds / 3600.0);
+    std::printf("%s\n", ok ? "totals match" : "TOTALS DIFFER");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+// Range totals: time inside random windows, answered by the per-task
+// prefix-sum index and by a linear scan over the timeframes, which must
+// agree.
+//
+//   range_totals [--sessions N] [--queries N] [--overlaps N]
+
+#include <cstdio>
+#include <random>
+
+#include "bench_util.h"
+#include "mothership_data.h"
+
+namespace {
+
+typedef std::chrono::system_clock::time_point TimePoint;
+
+void AddSession(MothershipTask& task, TimePoint start, std::chrono::seconds length) {
+    SingleTimeframe timeframe;
+    timeframe.startTime = start;
+    timeframe.endTime = start + length;
+    timeframe.started = false;
+    timeframe.finished = true;
+    int index = task.timeFrames.empty() ? 0 : task.timeFrames.rbegin()->first + 1;
+    task.timeFrames.emplace_hint(task.timeFrames.end(), index, timeframe);
+    task.currentTimeframe = index;
+}
+
+MothershipDuration LinearTotal(MothershipTask& task, TimePoint from, TimePoint to) {
+    MothershipDuration total(0);
+    for (auto& [index, timeframe] : task.timeFrames) {
+        if (!timeframe.Finished()) {
+            continue;
+        }
+        TimePoint begin = std::max(from, timeframe.startTime);
+        TimePoint end = std::min(to, timeframe.endTime);
+        if (begin < end) {
+            total += std::chrono::floor<MothershipDuration>(end - begin);
+        }
+    }
+    return total;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long long sessions = ArgInt(argc, argv, "--sessions", 200000);
+    long long queries = ArgInt(argc, argv, "--queries", 2000);
+    long long overlaps = ArgInt(argc, argv, "--overlaps", 100);
+
+    std::mt19937_64 rng(11);
+    MothershipTask task("range", MothershipColor(1));
+    TimePoint begin = std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now()) -
+                      std::chrono::days(3650);
+    TimePoint at = begin;
+    for (long long i = 0; i < sessions; ++i) {
+        at += std::chrono::seconds(60 + rng() % 3600);
+        std::chrono::seconds length(60 + rng() % 5400);
+        AddSession(task, at, length);
+        at += length;
+    }
+    // Sessions merged in from another device, overlapping local ones.
+    TimePoint finish = at;
+    for (long long i = 0; i < overlaps; ++i) {
+        auto offset = std::chrono::seconds(rng() % std::chrono::duration_cast<std::chrono::seconds>(finish - begin).count());
+        AddSession(task, begin + offset, std::chrono::seconds(600 + rng() % 7200));
+    }
+    std::printf("%zu timeframes over %.0f days\n", task.timeFrames.size(),
+                std::chrono::duration<double>(finish - begin).count() / 86400.0);
+
+    std::vector<std::pair<TimePoint, TimePoint>> windows;
+    auto span = std::chrono::duration_cast<std::chrono::seconds>(finish - begin).count();
+    for (long long i = 0; i < queries; ++i) {
+        TimePoint from = begin + std::chrono::seconds(rng() % span);
+        windows.emplace_back(from, from + std::chrono::seconds(rng() % (86400 * (1 + rng() % 30))));
+    }
+
+    BenchTimer timer;
+    task.TimeBetween(begin, begin);
+    double buildSeconds = timer.Seconds();
+
+    std::vector<MothershipDuration> indexed(windows.size());
+    timer = BenchTimer();
+    for (size_t i = 0; i < windows.size(); ++i) {
+        indexed[i] = task.TimeBetween(windows[i].first, windows[i].second);
+    }
+    double indexSeconds = timer.Seconds();
+
+    std::vector<MothershipDuration> scanned(windows.size());
+    timer = BenchTimer();
+    for (size_t i = 0; i < windows.size(); ++i) {
+        scanned[i] = LinearTotal(task, windows[i].first, windows[i].second);
+    }
+    double scanSeconds = timer.Seconds();
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < windows.size(); ++i) {
+        if (indexed[i] != scanned[i]) {
+            ++mismatches;
+        }
+    }
+    std::printf("index build:  %.2f ms\n", buildSeconds * 1000.0);
+    std::printf("index query:  %.2f us/query\n", indexSeconds * 1e6 / windows.size());
+    std::printf("linear scan:  %.2f us/query (%.0fx)\n", scanSeconds * 1e6 / windows.size(),
+                indexSeconds > 0 ? scanSeconds / indexSeconds : 0.0);
+    std::printf("%zu mismatches\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
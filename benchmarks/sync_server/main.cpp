@@ -0,0 +1,64 @@
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+
+#include "stand_in_server.h"
+
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void OnSignal(int) {
+    stopRequested = 1;
+}
+
+void Usage(const char* argv0) {
+    std::cerr << "usage: " << argv0 << " [--port N] [--latency MS] [--jitter MS]"
+              << " [--loss P] [--error P] [--retry-after S] [--rate-limit N] [--seed N]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MothershipFaultConfig faults;
+    unsigned short port = 8080;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            Usage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (!std::strcmp(argv[i - 1], "--port")) port = static_cast<unsigned short>(std::atoi(value));
+        else if (!std::strcmp(argv[i - 1], "--latency")) faults.latencyMs = std::atoi(value);
+        else if (!std::strcmp(argv[i - 1], "--jitter")) faults.jitterMs = std::atoi(value);
+        else if (!std::strcmp(argv[i - 1], "--loss")) faults.lossRate = std::atof(value);
+        else if (!std::strcmp(argv[i - 1], "--error")) faults.errorRate = std::atof(value);
+        else if (!std::strcmp(argv[i - 1], "--retry-after")) faults.retryAfterSeconds = std::atoi(value);
+        else if (!std::strcmp(argv[i - 1], "--rate-limit")) faults.rateLimitPerSecond = std::atoi(value);
+        else if (!std::strcmp(argv[i - 1], "--seed")) faults.seed = static_cast<unsigned>(std::atoi(value));
+        else {
+            Usage(argv[0]);
+            return 1;
+        }
+    }
+
+    MothershipStandInServer server(faults);
+    if (!server.Start(port)) {
+        std::cerr << "cannot listen on 127.0.0.1:" << port << "\n";
+        return 1;
+    }
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+    std::cout << "listening on " << server.BaseUrl() << std::endl;
+    while (!stopRequested) {
+        pause();
+    }
+    server.Stop();
+    std::cout << "events accepted: " << server.EventsAccepted()
+              << ", requests: " << server.Requests()
+              << ", injected faults: " << server.InjectedFaults()
+              << ", rate limited: " << server.RateLimited() << std::endl;
+    return 0;
+}
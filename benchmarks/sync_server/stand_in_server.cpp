@@ -0,0 +1,375 @@
+#include "stand_in_server.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "storage/serialization.h"
+#include "sync/replica_merge.h"
+
+namespace {
+
+std::string Lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+std::string Trim(const std::string& s) {
+    size_t begin = s.find_first_not_of(" \t");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(begin, end - begin + 1);
+}
+
+bool SendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+std::string Response(int status, const std::string& reason, const std::string& body,
+                     const std::string& extraHeaders = std::string()) {
+    std::string out = "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\n";
+    out += "Content-Type: application/json\r\n";
+    out += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    out += extraHeaders;
+    out += "\r\n";
+    out += body;
+    return out;
+}
+
+} // namespace
+
+MothershipStandInServer::MothershipStandInServer(const MothershipFaultConfig& faults) : faults(faults) {
+
+}
+
+MothershipStandInServer::~MothershipStandInServer() {
+    Stop();
+}
+
+std::string MothershipStandInServer::BaseUrl() const {
+    return "http://127.0.0.1:" + std::to_string(port);
+}
+
+bool MothershipStandInServer::Start(unsigned short requestedPort) {
+    if (running) {
+        return false;
+    }
+    listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        return false;
+    }
+    int one = 1;
+    ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(requestedPort);
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listenFd, 64) != 0) {
+        ::close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    socklen_t len = sizeof(addr);
+    ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+    port = ntohs(addr.sin_port);
+
+    running = true;
+    acceptThread = std::thread(&MothershipStandInServer::AcceptLoop, this);
+    return true;
+}
+
+void MothershipStandInServer::Stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    ::shutdown(listenFd, SHUT_RDWR);
+    ::close(listenFd);
+    listenFd = -1;
+    if (acceptThread.joinable()) {
+        acceptThread.join();
+    }
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (int fd : connectionFds) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+        threads.swap(connectionThreads);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void MothershipStandInServer::AcceptLoop() {
+    unsigned connection = 0;
+    while (running) {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EBADF || errno == EINVAL) {
+                // Stop() shut the socket down.
+                break;
+            }
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                // Out of descriptors or memory: give connections time to
+                // close instead of spinning.
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            // EINTR, ECONNABORTED and network errors on the pending
+            // connection: take the next one.
+            continue;
+        }
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        std::vector<std::thread> finished;
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            if (!running) {
+                ::close(fd);
+                break;
+            }
+            auto done = std::partition(connectionThreads.begin(), connectionThreads.end(), [&](const std::thread& t) {
+                return std::find(finishedThreads.begin(), finishedThreads.end(), t.get_id()) == finishedThreads.end();
+            });
+            std::move(done, connectionThreads.end(), std::back_inserter(finished));
+            connectionThreads.erase(done, connectionThreads.end());
+            finishedThreads.clear();
+            connectionFds.insert(fd);
+            connectionThreads.emplace_back(&MothershipStandInServer::Serve, this, fd, faults.seed + connection++);
+        }
+        for (auto& thread : finished) {
+            thread.join();
+        }
+    }
+}
+
+void MothershipStandInServer::Serve(int fd, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::uniform_int_distribution<int> jitter(-faults.jitterMs, faults.jitterMs);
+    std::string buffer;
+    Request request;
+
+    while (running && ReadRequest(fd, buffer, request)) {
+        requests += 1;
+        int delayMs = faults.latencyMs + (faults.jitterMs > 0 ? jitter(rng) : 0);
+        if (delayMs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+        }
+        if (faults.lossRate > 0.0 && chance(rng) < faults.lossRate) {
+            injectedFaults += 1;
+            break;
+        }
+        std::string reply;
+        if (OverRateLimit()) {
+            rateLimited += 1;
+            reply = Response(429, "Too Many Requests", "{}", "Retry-After: 1\r\n");
+        } else if (faults.errorRate > 0.0 && chance(rng) < faults.errorRate) {
+            injectedFaults += 1;
+            std::string headers;
+            if (faults.retryAfterSeconds > 0) {
+                headers = "Retry-After: " + std::to_string(faults.retryAfterSeconds) + "\r\n";
+            }
+            reply = Response(503, "Service Unavailable", "{}", headers);
+        } else {
+            reply = Handle(request);
+        }
+        if (!SendAll(fd, reply) || !request.keepAlive) {
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    connectionFds.erase(fd);
+    finishedThreads.push_back(std::this_thread::get_id());
+    ::close(fd);
+}
+
+bool MothershipStandInServer::ReadRequest(int fd, std::string& buffer, Request& request) {
+    char chunk[16384];
+    size_t headerEnd;
+    while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+
+    request = Request();
+    size_t contentLength = 0;
+    size_t lineStart = 0;
+    bool first = true;
+    while (lineStart < headerEnd) {
+        size_t lineEnd = buffer.find("\r\n", lineStart);
+        std::string line = buffer.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 2;
+        if (first) {
+            first = false;
+            size_t sp1 = line.find(' ');
+            size_t sp2 = line.find(' ', sp1 + 1);
+            if (sp1 == std::string::npos || sp2 == std::string::npos) {
+                return false;
+            }
+            request.method = line.substr(0, sp1);
+            request.path = line.substr(sp1 + 1, sp2 - sp1 - 1);
+            request.keepAlive = line.substr(sp2 + 1) != "HTTP/1.0";
+            continue;
+        }
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = Lower(Trim(line.substr(0, colon)));
+        std::string value = Trim(line.substr(colon + 1));
+        if (name == "content-length") {
+            contentLength = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "if-none-match") {
+            request.ifNoneMatch = value;
+        } else if (name == "connection") {
+            request.keepAlive = Lower(value) != "close";
+        }
+    }
+
+    size_t bodyStart = headerEnd + 4;
+    while (buffer.size() < bodyStart + contentLength) {
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+    request.body = buffer.substr(bodyStart, contentLength);
+    buffer.erase(0, bodyStart + contentLength);
+    return true;
+}
+
+bool MothershipStandInServer::OverRateLimit() {
+    if (faults.rateLimitPerSecond <= 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(rateMutex);
+    auto now = std::chrono::steady_clock::now();
+    if (now - rateWindowStart >= std::chrono::seconds(1)) {
+        rateWindowStart = now;
+        rateWindowCount = 0;
+    }
+    return ++rateWindowCount > faults.rateLimitPerSecond;
+}
+
+std::string MothershipStandInServer::Handle(const Request& request) {
+    if (request.method == "POST" && request.path == "/api/sync/events") {
+        nlohmann::json doc = nlohmann::json::parse(request.body, nullptr, false);
+        if (doc.is_discarded() || !doc.contains("events") || !doc["events"].is_array()) {
+            return Response(400, "Bad Request", "{\"error\":\"expected events array\"}");
+        }
+        size_t accepted = doc["events"].size();
+        eventsAccepted += accepted;
+        return Response(200, "OK", nlohmann::json{{"accepted", accepted}}.dump());
+    }
+    if (request.method == "POST" && request.path.rfind("/api/sync/", 0) == 0 && request.path != "/api/sync/events") {
+        return HandleReplica(request);
+    }
+    if (request.method == "GET" && (request.path == "/api/summary" || request.path == "/api/tasks")) {
+        uint64_t version = eventsAccepted.load();
+        std::string etag = "\"v" + std::to_string(version) + "\"";
+        if (request.ifNoneMatch == etag) {
+            return Response(304, "Not Modified", std::string(), "ETag: " + etag + "\r\n");
+        }
+        nlohmann::json body;
+        if (request.path == "/api/summary") {
+            body = {{"eventsAccepted", version}, {"requests", requests.load()}};
+        } else {
+            body = {{"tasks", nlohmann::json::array()}};
+        }
+        return Response(200, "OK", body.dump(), "ETag: " + etag + "\r\n");
+    }
+    return Response(404, "Not Found", "{\"error\":\"not found\"}");
+}
+
+void MothershipStandInServer::SeedReplica(const MothershipData& data) {
+    std::lock_guard<std::mutex> lock(replicaMutex);
+    replica = data;
+    treeStale = true;
+}
+
+uint64_t MothershipStandInServer::ReplicaRootHash() {
+    std::lock_guard<std::mutex> lock(replicaMutex);
+    if (treeStale) {
+        tree.Build(replica);
+        treeStale = false;
+    }
+    return tree.Hash("");
+}
+
+std::string MothershipStandInServer::HandleReplica(const Request& request) {
+    nlohmann::json doc = nlohmann::json::parse(request.body, nullptr, false);
+    if (doc.is_discarded() || !doc.is_object()) {
+        return Response(400, "Bad Request", "{\"error\":\"expected object\"}");
+    }
+    std::lock_guard<std::mutex> lock(replicaMutex);
+    if (treeStale) {
+        tree.Build(replica);
+        treeStale = false;
+    }
+
+    if (request.path == "/api/sync/merkle") {
+        nlohmann::json nodes = nlohmann::json::object();
+        for (auto& item : doc.value("nodes", nlohmann::json::array())) {
+            std::string key = item.get<std::string>();
+            uint64_t hash = tree.Hash(key);
+            if (hash == 0 && !key.empty()) {
+                continue;
+            }
+            nlohmann::json node = {{"hash", MerkleHashToHex(hash)}};
+            if (const auto* children = tree.Children(key)) {
+                nlohmann::json list = nlohmann::json::object();
+                for (auto& [child, childHash] : *children) {
+                    list[child] = MerkleHashToHex(childHash);
+                }
+                node["children"] = std::move(list);
+            }
+            nodes[key] = std::move(node);
+        }
+        return Response(200, "OK", nlohmann::json{{"nodes", std::move(nodes)}}.dump());
+    }
+    if (request.path == "/api/sync/leaves") {
+        std::vector<std::string> keys;
+        for (auto& item : doc.value("leaves", nlohmann::json::array())) {
+            keys.push_back(item.get<std::string>());
+        }
+        return Response(200, "OK", DataToJson(ExtractLeaves(replica, keys)).dump());
+    }
+    if (request.path == "/api/sync/history") {
+        MothershipData incoming;
+        if (!DataFromJson(doc, incoming)) {
+            return Response(400, "Bad Request", "{\"error\":\"malformed history\"}");
+        }
+        MergeReplica(replica, incoming);
+        tree.Build(replica);
+        return Response(200, "OK", nlohmann::json{{"root", MerkleHashToHex(tree.Hash(""))}}.dump());
+    }
+    return Response(404, "Not Found", "{\"error\":\"not found\"}");
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mothership_data.h"
+#include "sync/merkle_history.h"
+
+// Faults injected into every request the stand-in server handles.
+struct MothershipFaultConfig {
+    int latencyMs = 0;
+    int jitterMs = 0;
+    // Probability of closing the connection without answering.
+    double lossRate = 0.0;
+    // Probability of answering 503 instead of handling the request.
+    double errorRate = 0.0;
+    // Sent as Retry-After on injected 503s when positive.
+    int retryAfterSeconds = 0;
+    // Requests per second above which 429 + Retry-After is answered; 0 disables.
+    int rateLimitPerSecond = 0;
+    unsigned seed = 1;
+};
+
+// Minimal HTTP/1.1 server implementing the sync endpoints, for tests and
+// benchmarks only. It binds to the loopback interface exclusively.
+//
+//   POST /api/sync/events   {"events":[...]} -> {"accepted":n}
+//   GET  /api/summary       ETag-versioned summary of accepted events
+//   GET  /api/tasks         ETag-versioned task list
+//   POST /api/sync/merkle   {"nodes":[key...]} -> hash and children per node
+//   POST /api/sync/leaves   {"leaves":[key...]} -> partial history
+//   POST /api/sync/history  partial history, merged -> {"root":hash}
+class MothershipStandInServer {
+public:
+    explicit MothershipStandInServer(const MothershipFaultConfig& faults = MothershipFaultConfig());
+    ~MothershipStandInServer();
+
+    MothershipStandInServer(const MothershipStandInServer&) = delete;
+    MothershipStandInServer& operator=(const MothershipStandInServer&) = delete;
+
+    // Port 0 picks an ephemeral port; see Port().
+    bool Start(unsigned short port = 0);
+    void Stop();
+
+    inline unsigned short Port() const {
+        return port;
+    }
+    std::string BaseUrl() const;
+
+    inline uint64_t EventsAccepted() const {
+        return eventsAccepted.load();
+    }
+    inline uint64_t Requests() const {
+        return requests.load();
+    }
+    inline uint64_t InjectedFaults() const {
+        return injectedFaults.load();
+    }
+    inline uint64_t RateLimited() const {
+        return rateLimited.load();
+    }
+
+    // The server's own replica of the history.
+    void SeedReplica(const MothershipData& data);
+    uint64_t ReplicaRootHash();
+
+private:
+    struct Request {
+        std::string method;
+        std::string path;
+        std::string body;
+        std::string ifNoneMatch;
+        bool keepAlive = true;
+    };
+
+    void AcceptLoop();
+    void Serve(int fd, unsigned seed);
+    bool ReadRequest(int fd, std::string& buffer, Request& request);
+    std::string Handle(const Request& request);
+    std::string HandleReplica(const Request& request);
+    bool OverRateLimit();
+
+    MothershipFaultConfig faults;
+    int listenFd = -1;
+    unsigned short port = 0;
+    std::atomic<bool> running{false};
+    std::thread acceptThread;
+
+    std::mutex connectionsMutex;
+    std::set<int> connectionFds;
+    std::vector<std::thread> connectionThreads;
+    // Connection threads done serving, joined on the next accept.
+    std::vector<std::thread::id> finishedThreads;
+
+    std::atomic<uint64_t> eventsAccepted{0};
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> injectedFaults{0};
+    std::atomic<uint64_t> rateLimited{0};
+
+    std::mutex rateMutex;
+    std::chrono::steady_clock::time_point rateWindowStart;
+    int rateWindowCount = 0;
+
+    std::mutex replicaMutex;
+    MothershipData replica;
+    MothershipMerkleTree tree;
+    bool treeStale = true;
+};
@@ -0,0 +1,83 @@
+// End-to-end sync throughput: drives MothershipSyncClient against the
+// stand-in server on loopback and reports events/s and batch latency.
+//
+//   sync_throughput [--events N] [--batch N] [--fixed 1] [--latency MS]
+//                   [--jitter MS] [--loss P] [--error P] [--retry-after S]
+//                   [--rate-limit N] [--bucket 0]
+//
+// Without --fixed the batch size starts at --batch and adapts (AIMD).
+// --bucket 0 turns off adaptive pacing, leaving only Retry-After pauses.
+
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+#include "bench_util.h"
+#include "metrics.h"
+#include "sync/sync_client.h"
+#include "sync_server/stand_in_server.h"
+
+int main(int argc, char** argv) {
+    size_t eventCount = static_cast<size_t>(ArgInt(argc, argv, "--events", 100000));
+    size_t batchSize = static_cast<size_t>(ArgInt(argc, argv, "--batch", 100));
+    bool fixed = ArgInt(argc, argv, "--fixed", 0) != 0;
+    bool bucket = ArgInt(argc, argv, "--bucket", 1) != 0;
+
+    MothershipFaultConfig faults;
+    faults.latencyMs = static_cast<int>(ArgInt(argc, argv, "--latency", 0));
+    faults.jitterMs = static_cast<int>(ArgInt(argc, argv, "--jitter", 0));
+    faults.lossRate = ArgDouble(argc, argv, "--loss", 0.0);
+    faults.errorRate = ArgDouble(argc, argv, "--error", 0.0);
+    faults.retryAfterSeconds = static_cast<int>(ArgInt(argc, argv, "--retry-after", 0));
+    faults.rateLimitPerSecond = static_cast<int>(ArgInt(argc, argv, "--rate-limit", 0));
+
+    MothershipStandInServer server(faults);
+    if (!server.Start()) {
+        std::cerr << "cannot start stand-in server\n";
+        return 1;
+    }
+
+    std::vector<MothershipSyncEvent> events(eventCount);
+    for (size_t i = 0; i < eventCount; ++i) {
+        events[i].sequence = i;
+        events[i].kind = (i % 2) ? MothershipSyncEvent::StopTimeframe : MothershipSyncEvent::StartTimeframe;
+        events[i].task = "task-" + std::to_string(i % 64);
+        events[i].timestamp = 1700000000000LL + static_cast<long long>(i) * 1000;
+    }
+
+    std::string cachePath = (std::filesystem::temp_directory_path() / "mothership_bench_cache.json").string();
+    MothershipSyncClient client(server.BaseUrl(), cachePath);
+    if (fixed) {
+        client.SetBatchSize(batchSize);
+    } else {
+        MothershipBatchControllerConfig config;
+        config.initialBatch = batchSize;
+        client.SetBatchController(config);
+    }
+    client.SetMaxRetries(10);
+    client.SetAdaptiveRate(bucket);
+
+    MothershipUploadStats stats;
+    BenchTimer timer;
+    bool ok = client.UploadEvents(events, &stats);
+    double seconds = timer.Seconds();
+    server.Stop();
+    std::remove(cachePath.c_str());
+
+    std::printf("events:           %zu (batch %zu, %s)\n", stats.eventsSent, batchSize, fixed ? "fixed" : "adaptive");
+    std::printf("elapsed:          %.3f s\n", seconds);
+    std::printf("throughput:       %.0f events/s\n", seconds > 0 ? stats.eventsSent / seconds : 0.0);
+    std::printf("batch latency:    p50 %.3f ms, p99 %.3f ms\n",
+                Percentile(stats.batchLatenciesMs, 50), Percentile(stats.batchLatenciesMs, 99));
+    std::printf("failed attempts:  %zu (server injected %llu faults)\n",
+                stats.failedAttempts, static_cast<unsigned long long>(server.InjectedFaults()));
+    std::printf("rate limited:     %zu rounds (server answered %llu x 429)\n",
+                stats.rateLimited, static_cast<unsigned long long>(server.RateLimited()));
+    std::printf("pacing:           %s, %.1f requests/s at the end\n", bucket ? "adaptive" : "Retry-After only",
+                client.RateLimiter().Rate());
+    std::printf("final batch:      %zu x %d concurrent over %zu rounds\n",
+                client.BatchSize(), client.Concurrency(), stats.rounds);
+    std::printf("server accepted:  %llu events\n", static_cast<unsigned long long>(server.EventsAccepted()));
+    std::printf("metrics:\n%s\n", MothershipMetrics::Instance().Dump().c_str());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+// Panel text formatting: task timers, task rows and timestamps through
+// snprintf, iostreams and strftime against the table-driven writers,
+// with the heap allocations each makes. Every output is checked against
+// the snprintf/strftime one. (std::format is not in the toolchain's
+// standard library, so printf stands in as the baseline.)
+//
+//   text_format [--values N]
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <new>
+#include <random>
+#include <sstream>
+
+#include "bench_util.h"
+#include "ui/text_format.h"
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+struct Result {
+    double nanos;
+    double allocationsPer;
+    size_t mismatches;
+};
+
+template <typename Format>
+Result Measure(size_t count, const std::vector<std::string>& expected, Format format) {
+    char buffer[128];
+    size_t mismatches = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t length = format(i, buffer, sizeof(buffer));
+        if (std::string_view(buffer, length) != expected[i]) {
+            ++mismatches;
+        }
+    }
+    size_t before = allocations.load();
+    BenchTimer timer;
+    size_t sink = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sink += format(i, buffer, sizeof(buffer));
+    }
+    double seconds = timer.Seconds();
+    size_t made = allocations.load() - before;
+    if (sink == 0) {
+        std::printf("(empty)\n");
+    }
+    return Result{seconds * 1e9 / static_cast<double>(count), static_cast<double>(made) / static_cast<double>(count),
+                  mismatches};
+}
+
+void Print(const char* name, const Result& result, const Result& baseline) {
+    std::printf("  %-10s %7.1f ns  %4.2f allocs  (%.1fx)%s\n", name, result.nanos, result.allocationsPer,
+                baseline.nanos / result.nanos, result.mismatches ? "  MISMATCH" : "");
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char** argv) {
+    size_t count = static_cast<size_t>(ArgInt(argc, argv, "--values", 1000000));
+
+    // Timers up to ten days, titles of 4-30 characters, timestamps over
+    // thirty years.
+    std::mt19937_64 rng(23);
+    std::vector<MothershipDuration> durations(count);
+    std::vector<std::string> titles(count);
+    std::vector<std::time_t> stamps(count);
+    for (size_t i = 0; i < count; ++i) {
+        durations[i] = MothershipDuration(static_cast<int64_t>(rng() % (864000ULL * 1000000)));
+        titles[i] = "task-" + std::string(rng() % 26, static_cast<char>('a' + i % 26));
+        stamps[i] = static_cast<std::time_t>(946684800 + rng() % (30ULL * 365 * 86400));
+    }
+    MothershipTimeZone::Local();
+    bool ok = true;
+
+    auto seconds = [&](size_t i) {
+        return static_cast<long long>(std::chrono::duration_cast<std::chrono::seconds>(durations[i]).count());
+    };
+    auto printfClock = [&](size_t i, char* out, size_t size) -> size_t {
+        long long total = seconds(i);
+        return static_cast<size_t>(
+            std::snprintf(out, size, "%02lld:%02lld:%02lld", total / 3600, (total / 60) % 60, total % 60));
+    };
+    std::vector<std::string> expected(count);
+    char line[128];
+    for (size_t i = 0; i < count; ++i) {
+        expected[i].assign(line, printfClock(i, line, sizeof(line)));
+    }
+    std::printf("timer HH:MM:SS, %zu values\n", count);
+    Result baseline = Measure(count, expected, printfClock);
+    Print("snprintf", baseline, baseline);
+    Result stream = Measure(count, expected, [&](size_t i, char* out, size_t size) -> size_t {
+        long long total = seconds(i);
+        std::ostringstream text;
+        text << std::setfill('0') << std::setw(2) << total / 3600 << ':' << std::setw(2) << (total / 60) % 60 << ':'
+             << std::setw(2) << total % 60;
+        std::string s = text.str();
+        size_t n = std::min(s.size(), size);
+        std::memcpy(out, s.data(), n);
+        return n;
+    });
+    Print("iostream", stream, baseline);
+    Result table = Measure(count, expected, [&](size_t i, char* out, size_t size) {
+        return MothershipFormatClock(out, size, durations[i], true);
+    });
+    Print("table", table, baseline);
+    ok = ok && !stream.mismatches && !table.mismatches && table.allocationsPer == 0.0;
+
+    auto printfRow = [&](size_t i, char* out, size_t size) -> size_t {
+        char clock[32];
+        printfClock(i, clock, sizeof(clock));
+        return static_cast<size_t>(std::snprintf(out, size, "%c %-20.20s %s", i % 7 ? ' ' : '>', titles[i].c_str(), clock));
+    };
+    for (size_t i = 0; i < count; ++i) {
+        expected[i].assign(line, printfRow(i, line, sizeof(line)));
+    }
+    std::printf("task row, padded title and timer\n");
+    baseline = Measure(count, expected, printfRow);
+    Print("snprintf", baseline, baseline);
+    table = Measure(count, expected, [&](size_t i, char* out, size_t size) {
+        size_t length = 0;
+        out[length++] = i % 7 ? ' ' : '>';
+        out[length++] = ' ';
+        length += MothershipFormatColumns(out + length, size - length - 1, titles[i], 20);
+        out[length++] = ' ';
+        return length + MothershipFormatClock(out + length, size - length, durations[i], true);
+    });
+    Print("table", table, baseline);
+    ok = ok && !table.mismatches && table.allocationsPer == 0.0;
+
+    auto strftimeStamp = [&](size_t i, char* out, size_t size) -> size_t {
+        std::tm local{};
+        localtime_r(&stamps[i], &local);
+        return std::strftime(out, size, "%Y-%m-%d %H:%M:%S", &local);
+    };
+    for (size_t i = 0; i < count; ++i) {
+        expected[i].assign(line, strftimeStamp(i, line, sizeof(line)));
+    }
+    std::printf("timestamp YYYY-MM-DD HH:MM:SS, local time\n");
+    baseline = Measure(count, expected, strftimeStamp);
+    Print("strftime", baseline, baseline);
+    table = Measure(count, expected, [&](size_t i, char* out, size_t size) {
+        return MothershipFormatTimestamp(out, size, std::chrono::system_clock::from_time_t(stamps[i]));
+    });
+    Print("table", table, baseline);
+    ok = ok && !table.mismatches && table.allocationsPer == 0.0;
+
+    std::printf("%s\n", ok ? "outputs match, no allocations" : "OUTPUTS DIFFER OR ALLOCATE");
+    return ok ? 0 : 1;
+}
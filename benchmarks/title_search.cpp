@@ -0,0 +1,127 @@
+// Fuzzy title search: types queries into MothershipTitleSearch one
+// keystroke at a time over a large generated task list, deletes them again
+// with backspace, and types the last keystroke right after an AddTask
+// (which starts the search over). Every result is checked against a
+// subsequence match over all titles.
+//
+//   title_search [--tasks N] [--queries N]
+
+#include <cstdio>
+#include <random>
+
+#include "bench_util.h"
+#include "title_search.h"
+
+namespace {
+
+const char* words[] = {"write", "review", "report", "fix", "bug", "design", "meeting", "email", "read",
+                       "paper", "deploy", "server", "client", "sync", "plan", "budget", "call", "Draft",
+                       "Study", "Refactor", "test", "ui", "chart", "notes", "invoice", "travel"};
+
+inline char Fold(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Tasks whose title contains `query` as a case-insensitive subsequence,
+// in title order.
+std::vector<MothershipTask*> Expected(MothershipData& data, const std::string& query) {
+    std::vector<MothershipTask*> matches;
+    for (auto& [title, task] : data.tasks) {
+        size_t q = 0;
+        for (size_t i = 0; i < title.size() && q < query.size(); ++i) {
+            q += Fold(title[i]) == Fold(query[q]) ? 1 : 0;
+        }
+        if (q == query.size()) {
+            matches.push_back(&task);
+        }
+    }
+    return matches;
+}
+
+bool Same(const MothershipTitleSearch& search, const std::vector<MothershipTask*>& expected) {
+    if (search.Count() != expected.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (search.At(i) != expected[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string Title(std::mt19937& rng, int n) {
+    const size_t count = sizeof(words) / sizeof(words[0]);
+    return std::string(words[rng() % count]) + " " + words[rng() % count] + " " + std::to_string(n);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int taskCount = static_cast<int>(ArgInt(argc, argv, "--tasks", 100000));
+    int queryCount = static_cast<int>(ArgInt(argc, argv, "--queries", 50));
+
+    std::mt19937 rng(13);
+    MothershipData data;
+    for (int t = 0; t < taskCount; ++t) {
+        data.AddTask(Title(rng, t), MothershipColor(t % 8), false);
+    }
+    BenchTimer timer;
+    data.TitleIndex();
+    std::printf("%d titles, index built in %.2f ms\n", taskCount, timer.Seconds() * 1000.0);
+
+    // Queries are subsequences of existing titles, 2 to 8 characters long,
+    // so they narrow down gradually instead of emptying at once.
+    std::vector<std::string> queries;
+    for (int q = 0; q < queryCount; ++q) {
+        const std::string& title = std::next(data.tasks.begin(), rng() % data.tasks.size())->first;
+        size_t length = 2 + rng() % 7;
+        std::string query;
+        for (size_t i = 0; i < title.size() && query.size() < length; ++i) {
+            if (rng() % 3 == 0) {
+                query.push_back(title[i]);
+            }
+        }
+        if (query.size() >= 2) {
+            queries.push_back(query);
+        }
+    }
+
+    MothershipTitleSearch search;
+    std::vector<double> typed;
+    std::vector<double> erased;
+    std::vector<double> afterAdd;
+    size_t mismatches = 0;
+    size_t matches = 0;
+    auto step = [&](const std::string& query, std::vector<double>& times) {
+        BenchTimer stepTimer;
+        search.Update(data, query);
+        times.push_back(stepTimer.Seconds() * 1000.0);
+        mismatches += Same(search, Expected(data, query)) ? 0 : 1;
+    };
+    int added = 0;
+    for (const std::string& query : queries) {
+        for (size_t length = 1; length < query.size(); ++length) {
+            step(query.substr(0, length), typed);
+        }
+        // A new task throws every level away; the next keystroke rebuilds them.
+        data.AddTask(Title(rng, taskCount + added++), MothershipColor(1), false);
+        step(query, afterAdd);
+        matches += search.Count();
+        for (size_t length = query.size() - 1; length > 0; --length) {
+            step(query.substr(0, length), erased);
+        }
+    }
+
+    auto report = [](const char* label, const std::vector<double>& times) {
+        std::printf("%-10s %5zu keystrokes  p50 %.3f ms  p99 %.3f ms  max %.3f ms\n", label, times.size(),
+                    Percentile(times, 50), Percentile(times, 99), Percentile(times, 100));
+    };
+    report("typed", typed);
+    report("backspace", erased);
+    report("after add", afterAdd);
+    std::printf("%zu queries, %.1f matches each at full length\n", queries.size(),
+                queries.empty() ? 0.0 : static_cast<double>(matches) / queries.size());
+    std::printf("%s\n", mismatches == 0 ? "all results match" : "RESULTS DIFFER");
+    return mismatches == 0 ? 0 : 1;
+}
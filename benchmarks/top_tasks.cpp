@@ -0,0 +1,148 @@
+// Top-K tasks: ranks a large generated task list by time in day, week,
+// month, year and random windows, and checks each answer against scoring
+// every task. Then tasks are added and erased between queries (--churn
+// steps), which must not rebuild the bounds.
+//
+//   top_tasks [--tasks N] [--sessions N] [--k N] [--queries N] [--churn N]
+
+#include <cstdio>
+#include <random>
+
+#include "bench_util.h"
+#include "reports/top_tasks.h"
+
+namespace {
+
+typedef std::chrono::system_clock::time_point TimePoint;
+
+void AddSession(MothershipTask& task, TimePoint start, std::chrono::seconds length) {
+    SingleTimeframe timeframe;
+    timeframe.startTime = start;
+    timeframe.endTime = start + length;
+    timeframe.started = false;
+    timeframe.finished = true;
+    int index = task.timeFrames.empty() ? 0 : task.timeFrames.rbegin()->first + 1;
+    task.timeFrames.emplace_hint(task.timeFrames.end(), index, timeframe);
+    task.currentTimeframe = index;
+}
+
+// Every task scored, then the best k picked.
+std::vector<MothershipTaskTime> ScoreAll(MothershipData& data, TimePoint from, TimePoint to, size_t k) {
+    std::vector<MothershipTaskTime> all;
+    for (auto& [title, task] : data.tasks) {
+        auto time = task.TimeBetween(from, to);
+        if (time.count() > 0) {
+            all.push_back(MothershipTaskTime{&task, time});
+        }
+    }
+    auto better = [](const MothershipTaskTime& a, const MothershipTaskTime& b) {
+        return a.time != b.time ? a.time > b.time : a.task->title < b.task->title;
+    };
+    size_t n = std::min(k, all.size());
+    std::partial_sort(all.begin(), all.begin() + n, all.end(), better);
+    all.resize(n);
+    return all;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int taskCount = static_cast<int>(ArgInt(argc, argv, "--tasks", 100000));
+    int sessions = static_cast<int>(ArgInt(argc, argv, "--sessions", 40));
+    size_t k = static_cast<size_t>(ArgInt(argc, argv, "--k", 10));
+    int queries = static_cast<int>(ArgInt(argc, argv, "--queries", 20));
+    int churn = static_cast<int>(ArgInt(argc, argv, "--churn", 200));
+
+    // A few busy tasks and a long tail, each active in a stretch of the
+    // last two years.
+    std::mt19937 rng(9);
+    MothershipData data;
+    TimePoint now = std::chrono::system_clock::now();
+    for (int t = 0; t < taskCount; ++t) {
+        std::string title = "task-" + std::to_string(t);
+        data.AddTask(title, MothershipColor(t % 8), false);
+        MothershipTask& task = data.tasks.at(title);
+        int count = 1 + static_cast<int>(sessions * 20.0 / (1 + rng() % 400));
+        TimePoint at = now - std::chrono::days(rng() % 730);
+        for (int s = 0; s < count && at < now; ++s) {
+            std::chrono::seconds length(300 + rng() % 7200);
+            AddSession(task, at, length);
+            at += length + std::chrono::seconds(rng() % 172800);
+        }
+    }
+    data.InvalidateIndex();
+
+    BenchTimer timer;
+    data.TimeBounds();
+    std::printf("%d tasks, bounds built in %.2f ms\n", taskCount, timer.Seconds() * 1000.0);
+
+    struct Window {
+        const char* label;
+        TimePoint from;
+        TimePoint to;
+    };
+    std::vector<Window> windows = {
+        {"day", now - std::chrono::days(1), now},
+        {"week", now - std::chrono::days(7), now},
+        {"month", now - std::chrono::days(30), now},
+        {"year", now - std::chrono::days(365), now},
+    };
+    for (int q = 0; q < queries; ++q) {
+        TimePoint from = now - std::chrono::hours(rng() % (730 * 24));
+        windows.push_back({"random", from, from + std::chrono::hours(1 + rng() % (60 * 24))});
+    }
+
+    bool ok = true;
+    std::vector<double> topTimes;
+    std::vector<double> allTimes;
+    for (const Window& window : windows) {
+        std::vector<MothershipTaskTime> top;
+        timer = BenchTimer();
+        size_t evaluated = MothershipTopTasks(data, window.from, window.to, k, top);
+        double topSeconds = timer.Seconds();
+        timer = BenchTimer();
+        std::vector<MothershipTaskTime> expected = ScoreAll(data, window.from, window.to, k);
+        double allSeconds = timer.Seconds();
+        bool same = top.size() == expected.size();
+        for (size_t i = 0; same && i < top.size(); ++i) {
+            same = top[i].task == expected[i].task && top[i].time == expected[i].time;
+        }
+        ok = ok && same;
+        topTimes.push_back(topSeconds);
+        allTimes.push_back(allSeconds);
+        if (std::string(window.label) != "random") {
+            std::printf("%-6s top %zu: %.3f ms, %zu tasks scored; all: %.2f ms%s\n", window.label, k,
+                        topSeconds * 1000.0, evaluated, allSeconds * 1000.0, same ? "" : "  MISMATCH");
+        }
+    }
+    std::printf("all windows: p50 %.3f ms, max %.3f ms (scoring all: p50 %.2f ms)\n",
+                Percentile(topTimes, 50) * 1000.0, Percentile(topTimes, 100) * 1000.0,
+                Percentile(allTimes, 50) * 1000.0);
+
+    // Tasks added, run and erased between queries; the bounds follow them
+    // without being rebuilt.
+    std::vector<double> churnTimes;
+    for (int c = 0; c < churn; ++c) {
+        timer = BenchTimer();
+        std::string title = "added-" + std::to_string(c);
+        data.AddTask(title, MothershipColor(c % 8), true);
+        data.StopTask(title);
+        data.EraseTask("task-" + std::to_string(c * 7 % taskCount));
+        std::vector<MothershipTaskTime> top;
+        MothershipTopTasks(data, now - std::chrono::days(365), now + std::chrono::hours(1), k, top);
+        churnTimes.push_back(timer.Seconds());
+        if (c % 50 == 0) {
+            std::vector<MothershipTaskTime> expected =
+                ScoreAll(data, now - std::chrono::days(365), now + std::chrono::hours(1), k);
+            bool same = top.size() == expected.size();
+            for (size_t i = 0; same && i < top.size(); ++i) {
+                same = top[i].task == expected[i].task && top[i].time == expected[i].time;
+            }
+            ok = ok && same;
+        }
+    }
+    std::printf("add/stop/erase then top %zu: p50 %.3f ms, max %.3f ms over %d steps\n", k,
+                Percentile(churnTimes, 50) * 1000.0, Percentile(churnTimes, 100) * 1000.0, churn);
+    std::printf("%s\n", ok ? "all answers match" : "ANSWERS DIFFER");
+    return ok ? 0 : 1;
+}
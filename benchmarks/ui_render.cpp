@@ -0,0 +1,269 @@
+// Headless UI rendering: builds a large task list, drives the real panels
+// on a pseudo-terminal with a scripted key sequence and reports what each
+// frame cost in time, cells and terminal bytes. Keys are typed into the
+// pseudo-terminal and read back through MothershipUi::HandleInput, one
+// frame per input batch as in main(); each batch must take all the keys
+// sent for it and save at most once.
+//
+//   ui_render [--tasks N] [--running N] [--sessions N] [--rows N] [--cols N]
+//             [--script "STEP ..."] [--max-frame-ms X] [--max-tick-bytes N]
+//             [--low-bandwidth]
+//
+// Script steps, each optionally repeated with *N:
+//   UP DOWN PGUP PGDN HOME END ENTER BKSP   one key, then a frame
+//   TYPE:text                               types text ('_' is a space, '~' Enter), one frame per key
+//   PASTE:text                              the same keys as one input batch, one frame
+//   TICK                                    one second passes: a frame with no input
+//   RESIZE:RxC                              resizes the terminal and relays out
+//
+// Exits with 1 when a budget is exceeded, so it can gate CI.
+
+#include <clocale>
+#include <cstdio>
+#include <random>
+#include <sstream>
+
+#include "bench_util.h"
+#include "metrics.h"
+#include "ui/headless_terminal.h"
+#include "ui/mothership_ui.h"
+
+namespace {
+
+const char* defaultScript =
+    "TICK*5 PGDN*200 DOWN*100 END PGUP*50 HOME TYPE:add_bench-task ENTER TICK*20 "
+    "TYPE:stop_bench-task ENTER TYPE:seconds ENTER TICK*10 "
+    "PASTE:add_pasted-a~add_pasted-b~stop_pasted-a~erase_pasted-a~ TICK*5";
+
+struct StepStats {
+    std::vector<double> frameMs;
+    std::vector<double> frameBytes;
+    size_t cells = 0;
+};
+
+struct InputStats {
+    size_t batches = 0;
+    size_t keys = 0;
+    size_t saves = 0;
+    // Batches that did not take exactly the keys sent for them.
+    size_t split = 0;
+};
+
+// What the terminal sends for `key`: the terminfo sequence for special
+// keys, else the character.
+std::string KeyBytes(int key) {
+    const char* capability = nullptr;
+    switch (key) {
+        case KEY_UP: capability = "kcuu1"; break;
+        case KEY_DOWN: capability = "kcud1"; break;
+        case KEY_PPAGE: capability = "kpp"; break;
+        case KEY_NPAGE: capability = "knp"; break;
+        case KEY_HOME: capability = "khome"; break;
+        case KEY_END: capability = "kend"; break;
+        case KEY_BACKSPACE: capability = "kbs"; break;
+        default: return std::string(1, static_cast<char>(key));
+    }
+    const char* sequence = tigetstr(capability);
+    return sequence && sequence != reinterpret_cast<const char*>(-1) ? sequence : std::string();
+}
+
+inline char ScriptChar(char c) {
+    return c == '_' ? ' ' : c == '~' ? '\n' : c;
+}
+
+void Fill(MothershipData& data, int taskCount, int running, int sessions) {
+    std::mt19937 rng(11);
+    auto now = std::chrono::system_clock::now();
+    char title[32];
+    for (int t = 0; t < taskCount; ++t) {
+        std::snprintf(title, sizeof(title), "task-%06d", t);
+        MothershipColor color = t % 3 ? MothershipColor(rng() % 256, rng() % 256, rng() % 256) : MothershipColor(t % 8);
+        data.AddTask(title, color, false);
+        MothershipTask& task = data.tasks.find(title)->second;
+        for (int s = 0; s < sessions; ++s) {
+            SingleTimeframe timeframe;
+            timeframe.startTime = now - std::chrono::hours(24 * (s + 1)) + std::chrono::minutes(rng() % 600);
+            timeframe.endTime = timeframe.startTime + std::chrono::minutes(5 + rng() % 120);
+            timeframe.started = false;
+            timeframe.finished = true;
+            task.timeFrames.emplace(s, timeframe);
+            task.currentTimeframe = s;
+        }
+        if (t < running) {
+            data.ResumeTask(title);
+        }
+    }
+}
+
+// Moves running sessions back in time instead of sleeping, so a tick
+// changes the timer digits the way a real second would.
+void Advance(MothershipData& data, std::chrono::seconds by) {
+    for (MothershipTask* task : data.RunningTasks()) {
+        auto it = task->timeFrames.find(task->currentTimeframe);
+        if (it != task->timeFrames.end() && it->second.Started()) {
+            it->second.startTime -= by;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int taskCount = static_cast<int>(ArgInt(argc, argv, "--tasks", 100000));
+    int running = static_cast<int>(ArgInt(argc, argv, "--running", 20));
+    int sessions = static_cast<int>(ArgInt(argc, argv, "--sessions", 3));
+    int rows = static_cast<int>(ArgInt(argc, argv, "--rows", 50));
+    int cols = static_cast<int>(ArgInt(argc, argv, "--cols", 160));
+    std::string script = ArgValue(argc, argv, "--script", defaultScript);
+    double maxFrameMs = ArgDouble(argc, argv, "--max-frame-ms", 0.0);
+    long long maxTickBytes = ArgInt(argc, argv, "--max-tick-bytes", 0);
+    MothershipRenderProfile profile;
+    for (int i = 1; i < argc; ++i) {
+        profile.lowBandwidth = profile.lowBandwidth || !std::strcmp(argv[i], "--low-bandwidth");
+    }
+
+    setlocale(LC_ALL, "");
+    MothershipData data;
+    BenchTimer fillTimer;
+    Fill(data, taskCount, running, sessions);
+    std::printf("dataset: %d tasks, %d running, %d sessions each (%.1f ms)\n", taskCount, running, sessions,
+                fillTimer.Seconds() * 1000.0);
+
+    MothershipHeadlessTerminal terminal;
+    if (!terminal.Open(rows, cols)) {
+        std::fprintf(stderr, "cannot open a pseudo-terminal\n");
+        return 1;
+    }
+
+    StepStats keys;
+    StepStats ticks;
+    StepStats resizes;
+    InputStats input;
+    bool typed = true;
+    double firstFrameMs = 0.0;
+    {
+        MothershipUi ui(data);
+        ui.SetProfile(profile);
+        BenchTimer startTimer;
+        ui.Start(rows, cols);
+        ui.OutputToWindows();
+        firstFrameMs = startTimer.Seconds() * 1000.0;
+        MothershipRenderModel& render = ui.RenderModel();
+
+        auto frame = [&](StepStats& stats, auto&& action) {
+            BenchTimer timer;
+            action();
+            ui.OutputToWindows();
+            stats.frameMs.push_back(timer.Seconds() * 1000.0);
+            stats.frameBytes.push_back(static_cast<double>(render.LastFrameBytes()));
+            stats.cells += render.LastFrameCells();
+        };
+        // `bytes` typed as `count` keys, then handled as one batch with one
+        // frame, as main() does.
+        auto type = [&](const std::string& bytes, size_t count) {
+            frame(keys, [&] {
+                typed = terminal.Type(bytes) && typed;
+                MothershipInputBatch batch = ui.HandleInput();
+                input.batches += 1;
+                input.keys += batch.keys;
+                input.saves += batch.changed ? 1 : 0;
+                input.split += batch.keys != count ? 1 : 0;
+            });
+        };
+        auto key = [&](int ch) {
+            type(KeyBytes(ch), 1);
+        };
+
+        std::istringstream steps(script);
+        std::string step;
+        while (steps >> step) {
+            int repeat = 1;
+            size_t star = step.rfind('*');
+            if (star != std::string::npos) {
+                repeat = std::atoi(step.c_str() + star + 1);
+                step.resize(star);
+            }
+            for (int i = 0; i < repeat; ++i) {
+                if (step == "UP") key(KEY_UP);
+                else if (step == "DOWN") key(KEY_DOWN);
+                else if (step == "PGUP") key(KEY_PPAGE);
+                else if (step == "PGDN") key(KEY_NPAGE);
+                else if (step == "HOME") key(KEY_HOME);
+                else if (step == "END") key(KEY_END);
+                else if (step == "ENTER") key('\n');
+                else if (step == "BKSP") key(KEY_BACKSPACE);
+                else if (step == "TICK") frame(ticks, [&] { Advance(data, std::chrono::seconds(1)); });
+                else if (step.rfind("TYPE:", 0) == 0) {
+                    for (char c : step.substr(5)) {
+                        key(ScriptChar(c));
+                    }
+                } else if (step.rfind("PASTE:", 0) == 0) {
+                    std::string text = step.substr(6);
+                    std::transform(text.begin(), text.end(), text.begin(), ScriptChar);
+                    type(text, text.size());
+                } else if (step.rfind("RESIZE:", 0) == 0) {
+                    int newRows = 0, newCols = 0;
+                    if (std::sscanf(step.c_str() + 7, "%dx%d", &newRows, &newCols) != 2) {
+                        std::fprintf(stderr, "bad step %s\n", step.c_str());
+                        return 1;
+                    }
+                    frame(resizes, [&] {
+                        terminal.Resize(newRows, newCols);
+                        ui.InitializeWindows(newRows, newCols);
+                    });
+                } else {
+                    std::fprintf(stderr, "unknown step %s\n", step.c_str());
+                    return 1;
+                }
+            }
+        }
+    }
+    terminal.Settle();
+    long long emitted = terminal.BytesEmitted();
+    terminal.Close();
+
+    std::printf("first frame: %.2f ms\n", firstFrameMs);
+    bool withinBudget = true;
+    std::printf("input: %zu keys in %zu batches, one frame each, %zu saves\n", input.keys, input.batches,
+                input.saves);
+    if (!typed || input.split > 0) {
+        std::printf("  %zu batches did not take the keys typed for them%s\n", input.split,
+                    typed ? "" : " (the pseudo-terminal did not take them all)");
+        withinBudget = false;
+    }
+    auto report = [&](const char* label, const StepStats& stats, long long byteBudget) {
+        if (stats.frameMs.empty()) {
+            return;
+        }
+        double bytes = 0.0;
+        for (double b : stats.frameBytes) {
+            bytes += b;
+        }
+        double p99 = Percentile(stats.frameMs, 99);
+        double maxBytes = *std::max_element(stats.frameBytes.begin(), stats.frameBytes.end());
+        std::printf("%-8s %5zu frames  p50 %.3f ms  p99 %.3f ms  %8.1f cells/frame  %8.1f B/frame (max %.0f)\n",
+                    label, stats.frameMs.size(), Percentile(stats.frameMs, 50), p99,
+                    static_cast<double>(stats.cells) / stats.frameMs.size(), bytes / stats.frameMs.size(), maxBytes);
+        if (maxFrameMs > 0.0 && p99 > maxFrameMs) {
+            std::printf("  over budget: p99 %.3f ms > %.3f ms\n", p99, maxFrameMs);
+            withinBudget = false;
+        }
+        if (byteBudget > 0 && maxBytes > static_cast<double>(byteBudget)) {
+            std::printf("  over budget: %.0f B > %lld B per frame\n", maxBytes, byteBudget);
+            withinBudget = false;
+        }
+    };
+    report("keys", keys, 0);
+    report("ticks", ticks, maxTickBytes);
+    report("resizes", resizes, 0);
+    if (!ticks.frameBytes.empty()) {
+        double tickBytes = 0.0;
+        for (double b : ticks.frameBytes) {
+            tickBytes += b;
+        }
+        // A tick stands for one second, so this is the idle link usage.
+        std::printf("idle rate: %.1f B/s (9600 baud carries ~960 B/s)\n", tickBytes / ticks.frameBytes.size());
+    }
+    std::printf("terminal received %lld B in total\n", emitted);
+    return withinBudget ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+#include "commands.h"
+
+#include <cstdio>
+
+#include "reports/civil_time.h"
+#include "reports/overlap.h"
+#include "reports/top_tasks.h"
+#include "ui/text_format.h"
+
+namespace {
+
+std::string Trim(const std::string& s) {
+    size_t begin = s.find_first_not_of(" \t");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    size_t end = s.find_last_not_of(" \t");
+    return s.substr(begin, end - begin + 1);
+}
+
+std::string Short(MothershipDuration time) {
+    char buffer[32];
+    return std::string(buffer, MothershipFormatShort(buffer, sizeof(buffer), time));
+}
+
+std::string SessionReport(MothershipData& data, const std::string& title) {
+    const MothershipDurationHistogram* lengths = &data.SessionLengths();
+    if (!title.empty()) {
+        auto it = data.tasks.find(title);
+        if (it == data.tasks.end()) {
+            return "no task " + title;
+        }
+        lengths = &it->second.SessionLengths();
+    }
+    std::string text = title.empty() ? std::string() : title + ", ";
+    if (lengths->Count() == 0) {
+        return text + "no finished sessions";
+    }
+    return text + "p50 " + Short(lengths->Percentile(50)) + ", p90 " + Short(lengths->Percentile(90)) +
+           ", p99 " + Short(lengths->Percentile(99)) + " of " + std::to_string(lengths->Count()) + " sessions";
+}
+
+// Local midnight starting the current day, ISO week, month or year.
+bool PeriodStart(const std::string& period, std::chrono::system_clock::time_point now,
+                 std::chrono::system_clock::time_point& start) {
+    const MothershipTimeZone& zone = MothershipTimeZone::Local();
+    int64_t today = MothershipFloorDiv(zone.ToLocal(MothershipUnixSeconds(now)), 86400);
+    if (period == "day") {
+        start = zone.DayStart(now);
+    } else if (period == "week") {
+        start = zone.DayStart(now, -MothershipIsoWeekday(today));
+    } else if (period == "month") {
+        start = zone.MonthStart(now);
+    } else if (period == "year") {
+        start = zone.DateStart(MothershipCivilFromDays(today).year, 1, 1);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string Top(MothershipData& data, const std::string& period) {
+    auto now = std::chrono::system_clock::now();
+    std::chrono::system_clock::time_point start;
+    if (!PeriodStart(period, now, start)) {
+        return "usage: top day|week|month|year";
+    }
+    std::vector<MothershipTaskTime> top;
+    MothershipTopTasks(data, start, now, 3, top);
+    if (top.empty()) {
+        return "nothing tracked this " + period;
+    }
+    std::string text = "top " + period + ":";
+    for (size_t i = 0; i < top.size(); ++i) {
+        text += (i ? ", " : " ") + top[i].task->title + " " + Short(top[i].time);
+    }
+    return text;
+}
+
+std::string Overlap(MothershipData& data, const std::string& period) {
+    auto now = std::chrono::system_clock::now();
+    std::chrono::system_clock::time_point start;
+    if (!PeriodStart(period, now, start)) {
+        return "usage: overlap day|week|month|year";
+    }
+    MothershipOverlapReport report;
+    MothershipFindOverlaps(data, start, now, report);
+    // Tracked minus wall-clock: what summing the tasks counts twice.
+    MothershipDuration tracked = std::chrono::round<MothershipDuration>(report.tracked);
+    return "this " + period + ": " + Short(tracked) + " tracked, " + Short(tracked - report.covered) +
+           " double-counted";
+}
+
+std::string Report(MothershipData& data, const std::string& args) {
+    size_t space = args.find(' ');
+    std::string period = args.substr(0, space);
+    std::string title = space == std::string::npos ? std::string() : Trim(args.substr(space + 1));
+
+    if (period == "sessions") {
+        return SessionReport(data, title);
+    }
+    MothershipBucketKind kind;
+    if (period == "day") {
+        kind = BucketDay;
+    } else if (period == "week") {
+        kind = BucketWeek;
+    } else if (period == "month") {
+        kind = BucketMonth;
+    } else {
+        return "usage: report day|week|month|sessions [title]";
+    }
+    int64_t key = MothershipRollup::Key(kind, std::chrono::system_clock::now());
+    MothershipDuration time;
+    if (title.empty()) {
+        time = data.Rollup().Total(kind, key);
+    } else {
+        auto it = data.tasks.find(title);
+        if (it == data.tasks.end()) {
+            return "no task " + title;
+        }
+        time = it->second.Rollup().Total(kind, key);
+    }
+    long minutes = static_cast<long>(std::chrono::duration_cast<std::chrono::minutes>(time).count());
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%s%s: %ldh %02ldm", kind == BucketDay ? "today" : "this ",
+                  kind == BucketDay ? "" : period.c_str(), minutes / 60, minutes % 60);
+    return title.empty() ? std::string(buffer) : title + ", " + buffer;
+}
+
+} // namespace
+
+MothershipCommandResult ExecuteCommand(MothershipData& data, const std::string& line, std::string& message) {
+    std::string text = Trim(line);
+    if (text.empty()) {
+        return CommandIgnored;
+    }
+    size_t space = text.find(' ');
+    std::string verb = text.substr(0, space);
+    std::string title = space == std::string::npos ? std::string() : Trim(text.substr(space + 1));
+
+    if (verb == "quit" || verb == "q") {
+        return CommandQuit;
+    }
+    if (verb == "overlap") {
+        message = Overlap(data, title);
+        return CommandIgnored;
+    }
+    if (verb == "top") {
+        message = Top(data, title);
+        return CommandIgnored;
+    }
+    if (verb == "report") {
+        message = Report(data, title);
+        return CommandIgnored;
+    }
+    if (title.empty()) {
+        message = "usage: add|start|stop|erase <title>";
+        return CommandFailed;
+    }
+    if (verb == "add") {
+        if (data.AddTask(title, MothershipColor(-1), true)) {
+            message = "added " + title;
+            return CommandChanged;
+        }
+        message = title + " already exists";
+        return CommandFailed;
+    }
+    if (verb == "start") {
+        if (data.ResumeTask(title)) {
+            message = "started " + title;
+            return CommandChanged;
+        }
+        message = "cannot start " + title;
+        return CommandFailed;
+    }
+    if (verb == "stop") {
+        if (data.StopTask(title)) {
+            message = "stopped " + title;
+            return CommandChanged;
+        }
+        message = "cannot stop " + title;
+        return CommandFailed;
+    }
+    if (verb == "erase") {
+        if (data.EraseTask(title)) {
+            message = "erased " + title;
+            return CommandChanged;
+        }
+        message = "no task " + title;
+        return CommandFailed;
+    }
+    message = "unknown command " + verb;
+    return CommandFailed;
+}
+
+bool AnyTaskRunning(MothershipData& data) {
+    return !data.RunningTasks().empty();
+}
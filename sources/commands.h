@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+#include "mothership_data.h"
+
+enum MothershipCommandResult {
+    CommandIgnored,
+    CommandChanged,
+    CommandFailed,
+    CommandQuit
+};
+
+// Runs one line typed into the Command panel:
+//
+//   add <title>      create a task and start it
+//   start <title>    resume a stopped task
+//   stop <title>     stop a running task
+//   erase <title>    delete a task
+//   report day|week|month [title]
+//                    closed time in the current bucket, of one task or all
+//   report sessions [title]
+//                    session length percentiles
+//   top day|week|month|year
+//                    the three tasks with the most time so far this period
+//   overlap day|week|month|year
+//                    time counted twice because tasks ran at once
+//   quit             leave Mothership
+//
+// `message` receives a short status line for the panel.
+MothershipCommandResult ExecuteCommand(MothershipData& data, const std::string& line, std::string& message);
+
+bool AnyTaskRunning(MothershipData& data);
@@ -1,321 +1,146 @@
+#include <algorithm>
 #include <chrono>
+#include <clocale>
 #include <iostream>
 #include <ctime>
 #include <ncurses.h>
 #include <map>
+#include <sys/ioctl.h>
+#include <thread>
+#include <unistd.h>
 
-WINDOW* leftWin = nullptr;
-WINDOW* rightWin = nullptr;
-WINDOW* bottomWin = nullptr;
+#include "commands.h"
+#include "metrics.h"
+#include "mothership_data.h"
+#include "storage/snapshot.h"
+#include "ui/event_loop.h"
+#include "ui/mothership_ui.h"
 
-struct SingleTimeframe {
-    std::chrono::time_point<std::chrono::system_clock> startTime, endTime;
-
-    bool started = false;
-    bool finished = false;
-
-    SingleTimeframe();
-    bool Start() {
-        if (started) {
-            return false;
-        }
-        startTime = std::chrono::system_clock::now();
-        started = true;
-        return true;
-    }
-    bool Stop() {
-        if (finished || !started) {
-            return false;
-        }
-        endTime = std::chrono::system_clock::now();
-        finished = true;
-        started = false;
-        return true;
-    }
-    inline bool Finished() {
-        return (finished);
-    }
-    inline bool Started() {
-        return started;
-    }
-    inline std::chrono::duration<double> ElapsedTime() {
-        if (!started && !finished)
-            return std::chrono::duration<double>(0);
-        return endTime - startTime;
-    }
-};
-class MothershipColor {
-public:
-    bool isStandardColor = true;
-    bool isCustomColor = false;
-
-    int colorCode = -1;
-    unsigned short r = -1;
-    unsigned short g = -1;
-    unsigned short b = -1;
-
-    MothershipColor(int colorCode) {
-        this->colorCode = colorCode;
-    }
-    MothershipColor(unsigned short r, unsigned short g, unsigned short b) {
-        isCustomColor = true;
-        isStandardColor = false;
-
-        this->r = r;
-        this->g = g;
-        this->b = b;
-    }
-};
-class MothershipTask {
-public:
-
-    std::string title = "The Task";
-    std::map<int, SingleTimeframe> timeFrames;
-    std::chrono::duration<double> totalTime;
-    int currentTimeframe = -1;
-
-    MothershipColor color;
-
-    MothershipTask(const std::string& title, const MothershipColor& color) : title(title), color(color) {
-
-    }
-
-    inline void CalculateTotalTime() {
-        totalTime = std::chrono::duration<double>();
-        for (auto timeframe : timeFrames) {
-            SingleTimeframe& tf = timeframe.second;
-            if (tf.Finished()) {
-                totalTime += tf.ElapsedTime();
-            } else {
-                if (tf.Started()) {
-                    totalTime += std::chrono::system_clock::now() - tf.startTime;
-                    return;
-                } else {
-                    continue;
-                }
-            }
-        }
-    }
-    inline bool Stopped() {
-        if (timeFrames.empty()) {return true;}
-        if (currentTimeframe == -1) {return true;}
-        if (currentTimeframe != -1 && currentTimeframe >= 0) {
-            auto it = timeFrames.find(currentTimeframe);
-            if (it != timeFrames.end()) {
-                SingleTimeframe& stf = it->second;
-                return stf.Finished();
-            } else {
-                return true;
-            }
-        } else {
-            return true;
-        }
-    }
-    inline bool Started() {
-        if (timeFrames.empty()) {return false;}
-        if (currentTimeframe == -1) {return false;}
-        if (currentTimeframe != -1 && currentTimeframe >= 0) {
-            auto it = timeFrames.find(currentTimeframe);
-            if (it != timeFrames.end()) {
-                SingleTimeframe& stf = it->second;
-                return stf.Started();
-            } else {
-                return false;
-            }
-        } else {
-            return false;
-        }
-    }
-    bool StartTimeframe() {
-        if (timeFrames.empty()) {
-            auto ip = timeFrames.insert(std::make_pair(
-                0, SingleTimeframe()
-            ));
-            this->currentTimeframe = 0;
-            ip.first->second.Start();
-            return true;
-        }
-        if (currentTimeframe >= 0) {
-            auto it = timeFrames.find(currentTimeframe);
-            if (it != timeFrames.end()) {
-                bool hasStarted = it->second.Started();
-                if (hasStarted) {
-                    return false;
-                } else {
-                    bool hasFinished = it->second.Finished();
-                    if (hasFinished) {
-                        currentTimeframe += 1;
-                        auto ip = timeFrames.insert(std::make_pair(
-                            currentTimeframe,
-                            SingleTimeframe()
-                        ));
-                        ip.first->second.Start();
-                        return true;
-                    } else {
-                        it->second.Start();
-                        return true;
-                    }
-                }
-            } else {
-                auto ip = timeFrames.insert(std::make_pair(
-                    currentTimeframe, SingleTimeframe()
-                ));
-                ip.first->second.Start();
-                return true;
+MothershipData mothershipData;
+MothershipEventLoop eventLoop;
+MothershipUi ui(mothershipData);
+
+// Frame pacing; see Render().
+std::chrono::steady_clock::time_point lastFrameAt;
+bool framePending = false;
+size_t pendingKeys = 0;
+std::chrono::steady_clock::time_point pendingInputAt;
+
+// Snapshot writes happen on a worker thread; at most one is in flight.
+std::thread saveThread;
+bool saveInFlight = false;
+bool saveAgain = false;
+
+void ScheduleSave() {
+    if (saveInFlight) {
+        saveAgain = true;
+        return;
+    }
+    saveInFlight = true;
+    if (saveThread.joinable()) {
+        saveThread.join();
+    }
+    std::string encoded = EncodeSnapshot(mothershipData);
+    saveThread = std::thread([encoded = std::move(encoded)] {
+        bool ok = WriteSnapshot(encoded, MothershipSnapshotPath());
+        eventLoop.Post([ok] {
+            saveInFlight = false;
+            if (!ok) {
+                ui.SetStatus("could not save " + MothershipSnapshotPath());
             }
-        }
-        return false;
-    }
-    bool FinishTimeframe() {
-        if (timeFrames.empty()) {
-            return false;
-        } else {
-            if (currentTimeframe >= 0) {
-                auto it = timeFrames.find(currentTimeframe);
-                if (it != timeFrames.end()) {
-                    if (it->second.Started() && it->second.Finished() == false) {
-                        it->second.Stop();   
-                        CalculateTotalTime();
-                        return true;
-                    }
-                }
+            if (saveAgain) {
+                saveAgain = false;
+                ScheduleSave();
             }
-            return false;
-        }
-        return false;
-    }
-    unsigned int Count() {
-        return currentTimeframe + 1;
-    }
-};
-class MothershipData {
-public:
-    typedef std::map<std::string, MothershipTask> _Tasks;
-
-    _Tasks tasks;
+        });
+    });
+}
 
-    bool AddTask(const std::string& taskTitle, MothershipColor fgColor, bool start) {
-        auto ip = tasks.insert(
-            std::make_pair(
-                taskTitle,
-                MothershipTask(taskTitle, fgColor)
-            )
-        );
-        if (ip.second) {
-            if (start) {
-                ip.first->second.StartTimeframe();
-            }
-            return true;
-        }
-        return false;
-    }
-    bool EraseTask(const std::string& taskTitle) {
-        auto it = tasks.find(taskTitle);
-        if (it != tasks.end()) {
-            tasks.erase(it);
-            return true;
-        }
-        return false;
-    }
-    bool ResumeTask(const std::string& taskTitle) {
-        auto it = tasks.find(taskTitle);
-        if (it != tasks.end()) {
-            if (it->second.Stopped()) {
-                it->second.StartTimeframe();
-                return true;
-            }
-            return false;
-        }
-        return false;
+// Ticks only while a task runs: every second when seconds are shown,
+// on the minute otherwise.
+void UpdateTick() {
+    if (!AnyTaskRunning(mothershipData)) {
+        eventLoop.SetTick(std::chrono::milliseconds(0));
+    } else if (ui.ShowSeconds()) {
+        eventLoop.SetTick(std::chrono::seconds(1));
+    } else {
+        eventLoop.SetTick(std::chrono::minutes(1));
     }
-    bool StopTask(const std::string& taskTitle) {
-        auto it = tasks.find(taskTitle);
-        if (it != tasks.end()) {
-            if (it->second.Started()) {
-                it->second.FinishTimeframe();
-                return true;
-            }
-            return false;
-        }
-        return false;
-    }
-};
-
-MothershipData mothershipData;
-
-void InitializeWindows(int maxY, int maxX) {
-    int bottomHeight = 6;
-    int topHeight = maxY - bottomHeight;
-    if (topHeight < 3) topHeight = 3;
-    if (bottomHeight < 3) bottomHeight = 3;
-
-    int halfX = maxX / 2;
+}
 
-    // Sanity fallback: full screen single window if too small
-    if (topHeight + bottomHeight > maxY || halfX < 10) {
-        mvprintw(0, 0, "Terminal too small or bad split.");
-        refresh();
-        getch();
-        endwin();
-        exit(1);
+// Time from input becoming readable to the frame that shows it leaving
+// doupdate.
+void RecordInputLatency(std::chrono::steady_clock::time_point inputAt, size_t keys) {
+    static auto& batches = MothershipMetrics::Instance().Counter("ui.input_batches");
+    static auto& keysTotal = MothershipMetrics::Instance().Counter("ui.input_keys");
+    static auto& latencyTotal = MothershipMetrics::Instance().Counter("ui.input_latency_us_total");
+    static auto& latencyLast = MothershipMetrics::Instance().Gauge("ui.input_latency_ms");
+    static auto& latencyMax = MothershipMetrics::Instance().Gauge("ui.input_latency_max_ms");
+    long long us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - inputAt).count();
+    batches.fetch_add(1, std::memory_order_relaxed);
+    keysTotal.fetch_add(static_cast<long long>(keys), std::memory_order_relaxed);
+    latencyTotal.fetch_add(us, std::memory_order_relaxed);
+    latencyLast.store(us / 1000.0, std::memory_order_relaxed);
+    if (us / 1000.0 > latencyMax.load(std::memory_order_relaxed)) {
+        latencyMax.store(us / 1000.0, std::memory_order_relaxed);
     }
-
-    leftWin = newwin(topHeight, halfX, 0, 0);
-    rightWin = newwin(topHeight, maxX - halfX, 0, halfX);
-    bottomWin = newwin(bottomHeight, maxX, topHeight, 0);
-
-    box(leftWin, 0, 0);
-    box(rightWin, 0, 0);
-    box(bottomWin, 0, 0);
 }
 
-void OutputToWindows() {
-    init_pair(1, COLOR_WHITE, COLOR_BLACK);
-    init_pair(2, COLOR_RED, COLOR_BLACK);
-    init_pair(3, COLOR_GREEN, COLOR_BLACK);
-    init_pair(4, COLOR_CYAN, COLOR_BLACK);
-
-    // Paint entire windows with background color
-    wbkgd(leftWin, COLOR_PAIR(1));
-    wbkgd(rightWin, COLOR_PAIR(1));
-    wbkgd(bottomWin, COLOR_PAIR(1));
-
-    // Optional: clear to propagate the color across window area
-    wclear(leftWin);
-    wclear(rightWin);
-    wclear(bottomWin);
-
-    // Redraw borders
-    box(leftWin, 0, 0);
-    box(rightWin, 0, 0);
-    box(bottomWin, 0, 0);
-
-    // Draw text with foreground color on colored background
-    wattron(leftWin, A_BOLD);
-    mvwprintw(leftWin, 1, 2, "Tasks Regime");
-    wattroff(leftWin, A_BOLD);
-
-    wattron(rightWin, A_BOLD);
-    mvwprintw(rightWin, 1, 2, "Current Progress");
-    wattroff(rightWin, A_BOLD);
+// SIGWINCH arrives through the event loop, so ncurses never sees it: ask
+// the terminal for its size and relay out in place.
+void Resize() {
+    winsize size{};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_row == 0 || size.ws_col == 0) {
+        return;
+    }
+    resizeterm(size.ws_row, size.ws_col);
+    ui.InitializeWindows(size.ws_row, size.ws_col);
+}
 
-    wattron(bottomWin, A_BOLD);
-    mvwprintw(bottomWin, 1, 2, "Command");
-    wattroff(bottomWin, A_BOLD);
+// Frames are capped at the profile's maxFps. A frame asked for too soon is
+// held back and the loop wakes up when it is due, so bursts of input and
+// ticks collapse into one frame.
+void Render() {
+    if (!framePending) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    int maxFps = ui.Profile().maxFps;
+    if (maxFps > 0 && now - lastFrameAt < std::chrono::microseconds(1000000 / maxFps)) {
+        return;
+    }
+    ui.OutputToWindows();
+    lastFrameAt = now;
+    framePending = false;
+    if (pendingKeys > 0) {
+        RecordInputLatency(pendingInputAt, pendingKeys);
+        pendingKeys = 0;
+    }
+}
 
-    // Refresh windows
-    wrefresh(leftWin);
-    wrefresh(rightWin);
-    wrefresh(bottomWin);
+// Epoll timeout: until the held-back frame is due, or forever.
+int FrameWaitMs() {
+    int maxFps = ui.Profile().maxFps;
+    if (!framePending || maxFps <= 0) {
+        return -1;
+    }
+    auto due = lastFrameAt + std::chrono::microseconds(1000000 / maxFps);
+    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(due - std::chrono::steady_clock::now());
+    return static_cast<int>(std::max<long long>(0, wait.count() + 1));
 }
 
 int main() {
+    LoadSnapshot(mothershipData, MothershipSnapshotPath());
+
+    // The charts use Unicode block glyphs when the locale is UTF-8.
+    setlocale(LC_ALL, "");
     initscr();
     start_color();
     cbreak();
     noecho();
     curs_set(0);
     keypad(stdscr, TRUE);
+    nodelay(stdscr, TRUE);
 
     int maxY, maxX;
     getmaxyx(stdscr, maxY, maxX);
@@ -327,10 +152,59 @@ int main() {
     mvprintw(0, 0, "NCURSES ACTIVE - INIT OK");
     refresh();
 
-    InitializeWindows(maxY, maxX);
-    OutputToWindows();
+    ui.SetProfile(MothershipRenderProfile::FromEnvironment());
+    if (ui.Profile().lowBandwidth) {
+        MothershipFocusReports(stdout, true);
+    }
+    ui.Start(maxY, maxX);
+    ui.OutputToWindows();
+    lastFrameAt = std::chrono::steady_clock::now();
+
+    if (!eventLoop.Init() || !eventLoop.WatchInput(STDIN_FILENO)) {
+        endwin();
+        std::cerr << "cannot set up the event loop" << std::endl;
+        return 1;
+    }
+    UpdateTick();
+
+    MothershipEventLoop::Events events;
+    while (eventLoop.Wait(events, FrameWaitMs())) {
+        if (events.quit) {
+            break;
+        }
+        // Everything typed or pasted since the last wakeup is one batch:
+        // one frame and at most one save however many keys arrived.
+        MothershipInputBatch input = events.input ? ui.HandleInput() : MothershipInputBatch();
+        if (input.changed) {
+            ScheduleSave();
+        }
+        if (input.quit) {
+            break;
+        }
+        if (events.resize) {
+            Resize();
+        }
+        if (input.keys > 0 && pendingKeys == 0) {
+            pendingInputAt = events.inputAt;
+        }
+        pendingKeys += input.keys;
+        if (input.keys > 0 || events.tick || events.resize || events.completions > 0) {
+            framePending = true;
+        }
+        Render();
+        UpdateTick();
+    }
 
-    getch();
+    if (ui.Profile().lowBandwidth) {
+        MothershipFocusReports(stdout, false);
+    }
     endwin();
+    if (saveThread.joinable()) {
+        saveThread.join();
+    }
+    if (saveAgain) {
+        WriteSnapshot(EncodeSnapshot(mothershipData), MothershipSnapshotPath());
+    }
+    MothershipMetrics::Instance().Save();
     return 0;
 }
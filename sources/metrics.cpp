@@ -0,0 +1,42 @@
+#include "metrics.h"
+
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+#include "storage/data_directory.h"
+
+MothershipMetrics& MothershipMetrics::Instance() {
+    static MothershipMetrics instance;
+    return instance;
+}
+
+std::atomic<long long>& MothershipMetrics::Counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters[name];
+}
+
+std::atomic<double>& MothershipMetrics::Gauge(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return gauges[name];
+}
+
+std::string MothershipMetrics::Dump() const {
+    nlohmann::json doc = nlohmann::json::object();
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& [name, value] : counters) {
+        doc[name] = value.load(std::memory_order_relaxed);
+    }
+    for (auto& [name, value] : gauges) {
+        doc[name] = value.load(std::memory_order_relaxed);
+    }
+    return doc.dump(2);
+}
+
+bool MothershipMetrics::Save() const {
+    std::ofstream out(MothershipDataPath("metrics.json"), std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out << Dump() << "\n";
+    return static_cast<bool>(out);
+}
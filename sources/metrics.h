@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Process-wide named counters and gauges. Lookups take a lock, so hot
+// paths should keep the returned reference rather than look up by name.
+class MothershipMetrics {
+public:
+    static MothershipMetrics& Instance();
+
+    std::atomic<long long>& Counter(const std::string& name);
+    std::atomic<double>& Gauge(const std::string& name);
+
+    inline void Increment(const std::string& name, long long by = 1) {
+        Counter(name).fetch_add(by, std::memory_order_relaxed);
+    }
+    inline void SetGauge(const std::string& name, double value) {
+        Gauge(name).store(value, std::memory_order_relaxed);
+    }
+
+    // JSON object of every metric, sorted by name.
+    std::string Dump() const;
+    // Writes Dump() to metrics.json in the data directory.
+    bool Save() const;
+
+private:
+    MothershipMetrics() = default;
+
+    mutable std::mutex mutex;
+    std::map<std::string, std::atomic<long long>> counters;
+    std::map<std::string, std::atomic<double>> gauges;
+};
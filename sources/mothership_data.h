@@ -0,0 +1,596 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mothership_duration.h"
+#include "reports/duration_histogram.h"
+#include "reports/range_index.h"
+#include "reports/rollup.h"
+#include "reports/time_bounds.h"
+#include "sync/replica.h"
+#include "title_index.h"
+
+struct SingleTimeframe {
+    std::chrono::time_point<std::chrono::system_clock> startTime, endTime;
+
+    bool started = false;
+    bool finished = false;
+
+    // Replication identity: a globally unique id, the device that created
+    // the timeframe and the logical clock of its latest transition. Empty
+    // until Originate(); loads and merges copy it instead.
+    std::string id;
+    std::string originDevice;
+    uint64_t clock = 0;
+
+    // Makes this a new timeframe of the local device.
+    inline void Originate() {
+        id = MothershipNewId();
+        originDevice = MothershipLocalDevice();
+    }
+    bool Start() {
+        if (started) {
+            return false;
+        }
+        startTime = MothershipNow();
+        started = true;
+        clock = MothershipClockTick();
+        return true;
+    }
+    bool Stop() {
+        if (finished || !started) {
+            return false;
+        }
+        endTime = MothershipNow();
+        finished = true;
+        started = false;
+        clock = MothershipClockTick();
+        return true;
+    }
+    // Position in the idle < running < finished lattice used by merges.
+    inline int StateRank() const {
+        return finished ? 2 : (started ? 1 : 0);
+    }
+    inline bool Finished() {
+        return (finished);
+    }
+    inline bool Started() {
+        return started;
+    }
+    inline MothershipDuration ElapsedTime() {
+        if (!started && !finished)
+            return MothershipDuration(0);
+        return std::chrono::floor<MothershipDuration>(endTime - startTime);
+    }
+};
+class MothershipColor {
+public:
+    bool isStandardColor = true;
+    bool isCustomColor = false;
+
+    int colorCode = -1;
+    unsigned short r = -1;
+    unsigned short g = -1;
+    unsigned short b = -1;
+
+    MothershipColor(int colorCode) {
+        this->colorCode = colorCode;
+    }
+    MothershipColor(unsigned short r, unsigned short g, unsigned short b) {
+        isCustomColor = true;
+        isStandardColor = false;
+
+        this->r = r;
+        this->g = g;
+        this->b = b;
+    }
+};
+class MothershipTask {
+public:
+
+    std::string title = "The Task";
+    std::map<int, SingleTimeframe> timeFrames;
+    MothershipDuration totalTime{0};
+    int currentTimeframe = -1;
+
+    MothershipColor color;
+    // Last write to the task itself (creation, color); orders it against
+    // erasures. Set by MothershipData::AddTask, copied by loads and merges.
+    MothershipStamp stamp;
+
+    MothershipTask(const std::string& title, const MothershipColor& color) : title(title), color(color) {
+
+    }
+
+    inline void CalculateTotalTime() {
+        totalTime = MothershipDuration(0);
+        for (auto& timeframe : timeFrames) {
+            SingleTimeframe& tf = timeframe.second;
+            if (tf.Finished()) {
+                totalTime += tf.ElapsedTime();
+            } else {
+                if (tf.Started()) {
+                    totalTime += std::chrono::floor<MothershipDuration>(MothershipNow() - tf.startTime);
+                    return;
+                } else {
+                    continue;
+                }
+            }
+        }
+    }
+    inline bool Stopped() {
+        if (timeFrames.empty()) {return true;}
+        if (currentTimeframe == -1) {return true;}
+        if (currentTimeframe != -1 && currentTimeframe >= 0) {
+            auto it = timeFrames.find(currentTimeframe);
+            if (it != timeFrames.end()) {
+                SingleTimeframe& stf = it->second;
+                return stf.Finished();
+            } else {
+                return true;
+            }
+        } else {
+            return true;
+        }
+    }
+    inline bool Started() {
+        if (timeFrames.empty()) {return false;}
+        if (currentTimeframe == -1) {return false;}
+        if (currentTimeframe != -1 && currentTimeframe >= 0) {
+            auto it = timeFrames.find(currentTimeframe);
+            if (it != timeFrames.end()) {
+                SingleTimeframe& stf = it->second;
+                return stf.Started();
+            } else {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    bool StartTimeframe() {
+        if (timeFrames.empty()) {
+            auto ip = timeFrames.insert(std::make_pair(
+                0, SingleTimeframe()
+            ));
+            this->currentTimeframe = 0;
+            ip.first->second.Originate();
+            ip.first->second.Start();
+            return true;
+        }
+        if (currentTimeframe >= 0) {
+            auto it = timeFrames.find(currentTimeframe);
+            if (it != timeFrames.end()) {
+                bool hasStarted = it->second.Started();
+                if (hasStarted) {
+                    return false;
+                } else {
+                    bool hasFinished = it->second.Finished();
+                    if (hasFinished) {
+                        currentTimeframe += 1;
+                        auto ip = timeFrames.insert(std::make_pair(
+                            currentTimeframe,
+                            SingleTimeframe()
+                        ));
+                        ip.first->second.Originate();
+                        ip.first->second.Start();
+                        return true;
+                    } else {
+                        it->second.Start();
+                        return true;
+                    }
+                }
+            } else {
+                auto ip = timeFrames.insert(std::make_pair(
+                    currentTimeframe, SingleTimeframe()
+                ));
+                ip.first->second.Originate();
+                ip.first->second.Start();
+                return true;
+            }
+        }
+        return false;
+    }
+    bool FinishTimeframe() {
+        if (timeFrames.empty()) {
+            return false;
+        } else {
+            if (currentTimeframe >= 0) {
+                auto it = timeFrames.find(currentTimeframe);
+                if (it != timeFrames.end()) {
+                    if (it->second.Started() && it->second.Finished() == false) {
+                        it->second.Stop();   
+                        CalculateTotalTime();
+                        if (rollupValid) {
+                            rollup.Add(it->second.startTime, it->second.endTime);
+                        }
+                        if (rangeValid && !rangeIndex.Append(it->second.startTime, it->second.endTime)) {
+                            rangeValid = false;
+                        }
+                        if (lengthsValid) {
+                            lengths.Record(it->second.ElapsedTime());
+                        }
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+        return false;
+    }
+    unsigned int Count() {
+        return currentTimeframe + 1;
+    }
+    // Closed time per hour/day/week/month. Built from the finished
+    // timeframes on first use, then extended by FinishTimeframe; a running
+    // session is not counted until it is stopped.
+    const MothershipRollup& Rollup() {
+        if (!rollupValid) {
+            rollup.Clear();
+            for (auto& timeframe : timeFrames) {
+                if (timeframe.second.Finished()) {
+                    rollup.Add(timeframe.second.startTime, timeframe.second.endTime);
+                }
+            }
+            rollupValid = true;
+        }
+        return rollup;
+    }
+    // Time spent inside [from, to), including the running session up to
+    // now. O(log n) in the number of timeframes once the index is built.
+    // Finished time from the session index plus the running session so far;
+    // O(1) once the index is built, where CalculateTotalTime walks every
+    // timeframe.
+    MothershipDuration TotalTime() {
+        MothershipDuration total(FinishedSessions().Sum());
+        if (Started()) {
+            auto it = timeFrames.find(currentTimeframe);
+            if (it != timeFrames.end()) {
+                total += std::chrono::floor<MothershipDuration>(MothershipNow() - it->second.startTime);
+            }
+        }
+        return total;
+    }
+    MothershipDuration TimeBetween(MothershipTimePoint from, MothershipTimePoint to) {
+        MothershipDuration total = FinishedSessions().Total(from, to);
+        if (Started()) {
+            SingleTimeframe& running = timeFrames[currentTimeframe];
+            auto begin = std::max(from, running.startTime);
+            auto end = std::min(to, MothershipNow());
+            if (begin < end) {
+                total += std::chrono::floor<MothershipDuration>(end - begin);
+            }
+        }
+        return total;
+    }
+    // Finished sessions overlapping [from, to): count and shortest/longest
+    // clipped length, in microseconds.
+    inline MothershipIntervalStats SessionsBetween(MothershipTimePoint from, MothershipTimePoint to) {
+        return FinishedSessions().Stats(from, to);
+    }
+    // Lengths of the finished sessions; built on first use, then extended
+    // by FinishTimeframe.
+    const MothershipDurationHistogram& SessionLengths() {
+        if (!lengthsValid) {
+            lengths.Clear();
+            for (auto& timeframe : timeFrames) {
+                if (timeframe.second.Finished()) {
+                    lengths.Record(timeframe.second.ElapsedTime());
+                }
+            }
+            lengthsValid = true;
+        }
+        return lengths;
+    }
+    // The histogram if it is built, else null; for const readers such as snapshots.
+    inline const MothershipDurationHistogram* BuiltSessionLengths() const {
+        return lengthsValid ? &lengths : nullptr;
+    }
+    // Takes a histogram restored with the timeframes it describes.
+    inline void AdoptSessionLengths(MothershipDurationHistogram histogram) {
+        lengths = std::move(histogram);
+        lengthsValid = true;
+    }
+    // Must be called after `timeFrames` is changed other than through the methods above.
+    inline void InvalidateAggregates() {
+        rollupValid = false;
+        rangeValid = false;
+        lengthsValid = false;
+    }
+
+    // The finished sessions sorted by start, in microsecond ticks.
+    //
+    // This and the caches above are built on first use, so concurrent readers
+    // of one task must not race; different tasks share nothing.
+    const MothershipRangeIndex& FinishedSessions() {
+        if (!rangeValid) {
+            rangeIndex.Clear();
+            for (auto& timeframe : timeFrames) {
+                if (timeframe.second.Finished()) {
+                    rangeIndex.Insert(timeframe.second.startTime, timeframe.second.endTime);
+                }
+            }
+            rangeIndex.Finish();
+            rangeValid = true;
+        }
+        return rangeIndex;
+    }
+
+private:
+    MothershipRollup rollup;
+    MothershipRangeIndex rangeIndex;
+    MothershipDurationHistogram lengths;
+    bool rollupValid = false;
+    bool rangeValid = false;
+    bool lengthsValid = false;
+};
+class MothershipData {
+public:
+    typedef std::map<std::string, MothershipTask> _Tasks;
+    typedef std::map<std::string, MothershipStamp> _Tombstones;
+    typedef std::vector<MothershipTask*> _TaskIndex;
+
+    _Tasks tasks;
+    // Erased task titles, kept so a merge does not resurrect them.
+    _Tombstones tombstones;
+
+    MothershipData() = default;
+    MothershipData(const MothershipData& other) : tasks(other.tasks), tombstones(other.tombstones) {
+
+    }
+    MothershipData& operator=(const MothershipData& other) {
+        tasks = other.tasks;
+        tombstones = other.tombstones;
+        InvalidateIndex();
+        return *this;
+    }
+
+    bool AddTask(const std::string& taskTitle, MothershipColor fgColor, bool start) {
+        auto ip = tasks.insert(
+            std::make_pair(
+                taskTitle,
+                MothershipTask(taskTitle, fgColor)
+            )
+        );
+        if (ip.second) {
+            ip.first->second.stamp = MothershipStamp{MothershipClockTick(), MothershipLocalDevice()};
+            indexGeneration += 1;
+            if (indexValid) {
+                IndexInsert(order, &ip.first->second);
+                titleIndex.Insert(&ip.first->second);
+            }
+            if (boundsValid) {
+                bounds.Add(&ip.first->second);
+            }
+            if (start) {
+                ip.first->second.StartTimeframe();
+                if (indexValid) {
+                    IndexInsert(running, &ip.first->second);
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+    bool EraseTask(const std::string& taskTitle) {
+        auto it = tasks.find(taskTitle);
+        if (it != tasks.end()) {
+            indexGeneration += 1;
+            if (indexValid) {
+                IndexErase(order, taskTitle);
+                IndexErase(running, taskTitle);
+                titleIndex.Erase(taskTitle);
+                if (titleIndex.NeedsCompaction()) {
+                    InvalidateIndex();
+                }
+            }
+            if (boundsValid) {
+                // Dropped from the bounds lazily; past a few, rebuild instead.
+                bounds.Erase(&it->second);
+                boundsValid = bounds.Erased() < 1024;
+            }
+            tasks.erase(it);
+            rollupValid = false;
+            lengthsValid = false;
+            tombstones[taskTitle] = MothershipStamp{MothershipClockTick(), MothershipLocalDevice()};
+            return true;
+        }
+        return false;
+    }
+    bool ResumeTask(const std::string& taskTitle) {
+        auto it = tasks.find(taskTitle);
+        if (it != tasks.end()) {
+            if (it->second.Stopped()) {
+                it->second.StartTimeframe();
+                if (indexValid) {
+                    IndexInsert(running, &it->second);
+                }
+                return true;
+            }
+            return false;
+        }
+        return false;
+    }
+    bool StopTask(const std::string& taskTitle) {
+        auto it = tasks.find(taskTitle);
+        if (it != tasks.end()) {
+            if (it->second.Started()) {
+                it->second.FinishTimeframe();
+                if (indexValid) {
+                    IndexErase(running, taskTitle);
+                }
+                SingleTimeframe& closed = it->second.timeFrames[it->second.currentTimeframe];
+                if (rollupValid) {
+                    rollup.Add(closed.startTime, closed.endTime);
+                }
+                if (lengthsValid) {
+                    lengths.Record(closed.ElapsedTime());
+                }
+                if (boundsValid) {
+                    // Its bounds are now too low; past a few, rebuild instead.
+                    bounds.MarkStale(&it->second);
+                    boundsValid = bounds.Stale().size() < 1024;
+                }
+                return true;
+            }
+            return false;
+        }
+        return false;
+    }
+
+    // Positional access in title order, for list views. O(1) once the
+    // index is built; AddTask/EraseTask keep it current.
+    inline size_t TaskCount() const {
+        return tasks.size();
+    }
+    inline MothershipTask& TaskAt(size_t index) {
+        EnsureIndex();
+        return *order[index];
+    }
+    // Position of `taskTitle`, or -1. O(log n).
+    long IndexOf(const std::string& taskTitle) {
+        EnsureIndex();
+        auto it = std::lower_bound(order.begin(), order.end(), taskTitle,
+                                   [](const MothershipTask* task, const std::string& title) { return task->title < title; });
+        if (it != order.end() && (*it)->title == taskTitle) {
+            return static_cast<long>(it - order.begin());
+        }
+        return -1;
+    }
+    // Tasks started through this class, in title order.
+    inline const _TaskIndex& RunningTasks() {
+        EnsureIndex();
+        return running;
+    }
+    // Title search index; kept current by AddTask/EraseTask.
+    inline const MothershipTitleIndex& TitleIndex() {
+        EnsureIndex();
+        return titleIndex;
+    }
+    // Changes whenever the set of titles may have changed.
+    inline unsigned long long IndexGeneration() {
+        EnsureIndex();
+        return indexGeneration;
+    }
+    // Changes when tasks may have changed other than through the methods
+    // above (loads, merges); AddTask/EraseTask only move IndexGeneration.
+    inline unsigned long long ReloadGeneration() {
+        EnsureIndex();
+        return reloadGeneration;
+    }
+    // Closed time of all tasks per hour/day/week/month: the per-task
+    // rollups merged once, then extended by StopTask.
+    const MothershipRollup& Rollup() {
+        EnsureIndex();
+        if (!rollupValid) {
+            rollup.Clear();
+            for (MothershipTask* task : order) {
+                rollup.Merge(task->Rollup());
+            }
+            rollupValid = true;
+        }
+        return rollup;
+    }
+    // Upper bounds on each task's time in a window, for top-K queries.
+    const MothershipTimeBounds& TimeBounds() {
+        EnsureIndex();
+        if (!boundsValid) {
+            bounds.Build(order);
+            boundsValid = true;
+        }
+        return bounds;
+    }
+    // Session lengths of all tasks: the per-task histograms merged once,
+    // then extended by StopTask.
+    const MothershipDurationHistogram& SessionLengths() {
+        EnsureIndex();
+        if (!lengthsValid) {
+            lengths.Clear();
+            for (MothershipTask* task : order) {
+                lengths.Merge(task->SessionLengths());
+            }
+            lengthsValid = true;
+        }
+        return lengths;
+    }
+    // Time spent by all tasks inside [from, to); O(tasks * log n).
+    MothershipDuration TimeBetween(MothershipTimePoint from, MothershipTimePoint to) {
+        EnsureIndex();
+        MothershipDuration total(0);
+        for (MothershipTask* task : order) {
+            total += task->TimeBetween(from, to);
+        }
+        return total;
+    }
+    MothershipDuration TimeBetween(const std::string& taskTitle, MothershipTimePoint from, MothershipTimePoint to) {
+        auto it = tasks.find(taskTitle);
+        if (it == tasks.end()) {
+            return MothershipDuration(0);
+        }
+        EnsureIndex();
+        return it->second.TimeBetween(from, to);
+    }
+    // Must be called after `tasks` is changed other than through the methods above.
+    inline void InvalidateIndex() {
+        indexValid = false;
+        rollupValid = false;
+        lengthsValid = false;
+        boundsValid = false;
+        indexGeneration += 1;
+        reloadGeneration += 1;
+    }
+
+private:
+    static void IndexInsert(_TaskIndex& index, MothershipTask* task) {
+        auto it = std::lower_bound(index.begin(), index.end(), task->title,
+                                   [](const MothershipTask* t, const std::string& title) { return t->title < title; });
+        if (it == index.end() || *it != task) {
+            index.insert(it, task);
+        }
+    }
+    static void IndexErase(_TaskIndex& index, const std::string& title) {
+        auto it = std::lower_bound(index.begin(), index.end(), title,
+                                   [](const MothershipTask* t, const std::string& t2) { return t->title < t2; });
+        if (it != index.end() && (*it)->title == title) {
+            index.erase(it);
+        }
+    }
+    void EnsureIndex() {
+        if (indexValid && order.size() == tasks.size()) {
+            return;
+        }
+        order.clear();
+        running.clear();
+        titleIndex.Clear();
+        order.reserve(tasks.size());
+        for (auto& [title, task] : tasks) {
+            order.push_back(&task);
+            if (task.Started()) {
+                running.push_back(&task);
+            }
+            titleIndex.Append(&task);
+        }
+        indexValid = true;
+        boundsValid = false;
+        indexGeneration += 1;
+        reloadGeneration += 1;
+    }
+
+    _TaskIndex order;
+    _TaskIndex running;
+    MothershipTitleIndex titleIndex;
+    MothershipRollup rollup;
+    MothershipDurationHistogram lengths;
+    MothershipTimeBounds bounds;
+    bool indexValid = false;
+    bool rollupValid = false;
+    bool lengthsValid = false;
+    bool boundsValid = false;
+    unsigned long long indexGeneration = 0;
+    unsigned long long reloadGeneration = 0;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Stored and aggregated durations are whole microseconds in 64 bits: exact,
+// the same on every machine, and summable with integer SIMD. Floating point
+// is for display only.
+typedef std::chrono::duration<int64_t, std::micro> MothershipDuration;
+typedef std::chrono::system_clock::time_point MothershipTimePoint;
+
+// Time points are kept to the microsecond, as snapshots store them, so a
+// loaded history sums to exactly the same totals.
+inline MothershipTimePoint MothershipNow() {
+    return std::chrono::floor<MothershipDuration>(std::chrono::system_clock::now());
+}
+
+// Microseconds since the epoch, the tick of the report indexes.
+inline int64_t MothershipTicks(MothershipTimePoint when) {
+    return std::chrono::floor<MothershipDuration>(when.time_since_epoch()).count();
+}
+inline MothershipTimePoint MothershipFromTicks(int64_t ticks) {
+    return MothershipTimePoint(MothershipDuration(ticks));
+}
+
+inline double MothershipSeconds(MothershipDuration duration) {
+    return std::chrono::duration<double>(duration).count();
+}
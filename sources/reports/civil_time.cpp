@@ -0,0 +1,134 @@
+#include "reports/civil_time.h"
+
+#include <algorithm>
+#include <ctime>
+#include <limits>
+
+namespace {
+
+constexpr int64_t secondsPerDay = 86400;
+
+int64_t LibcOffset(int64_t utc) {
+    std::time_t t = static_cast<std::time_t>(utc);
+    std::tm local{};
+    localtime_r(&t, &local);
+    return local.tm_gmtoff;
+}
+
+MothershipTimePoint FromSeconds(int64_t seconds) {
+    return MothershipTimePoint(std::chrono::seconds(seconds));
+}
+
+} // namespace
+
+int64_t MothershipDaysFromCivil(int year, int month, int day) {
+    int64_t y = static_cast<int64_t>(year) - (month <= 2);
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yearOfEra = y - era * 400; // years from March 1st, [0, 399]
+    int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+MothershipCivilDate MothershipCivilFromDays(int64_t days) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t shifted = (5 * dayOfYear + 2) / 153; // months from March
+    int day = static_cast<int>(dayOfYear - (153 * shifted + 2) / 5 + 1);
+    int month = static_cast<int>(shifted < 10 ? shifted + 3 : shifted - 9);
+    return MothershipCivilDate{static_cast<int>(yearOfEra + era * 400 + (month <= 2)), month, day};
+}
+
+MothershipTimeZone::MothershipTimeZone(int firstYear, int lastYear) {
+    first = MothershipDaysFromCivil(firstYear, 1, 1) * secondsPerDay;
+    last = MothershipDaysFromCivil(lastYear + 1, 1, 1) * secondsPerDay;
+    at.push_back(std::numeric_limits<int64_t>::min());
+    offsets.push_back(LibcOffset(first));
+    const int64_t step = 7 * secondsPerDay;
+    for (int64_t t = first; t < last;) {
+        int64_t next = std::min(t + step, last);
+        if (LibcOffset(next) == offsets.back()) {
+            t = next;
+            continue;
+        }
+        // The offset changed in (t, next]: find the first second it differs.
+        int64_t low = t;
+        int64_t high = next;
+        while (high - low > 1) {
+            int64_t middle = low + (high - low) / 2;
+            if (LibcOffset(middle) == offsets.back()) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        at.push_back(high);
+        offsets.push_back(LibcOffset(high));
+        t = high;
+    }
+}
+
+const MothershipTimeZone& MothershipTimeZone::Local() {
+    static const MothershipTimeZone zone(1970, 2100);
+    return zone;
+}
+
+int64_t MothershipTimeZone::Offset(int64_t utc) const {
+    if (utc < first || utc >= last) {
+        return LibcOffset(utc);
+    }
+    // Last transition at or before `utc`; the loop has no data-dependent
+    // branch, only conditional moves.
+    const int64_t* base = at.data();
+    size_t count = at.size();
+    while (count > 1) {
+        size_t half = count / 2;
+        base = base[half] <= utc ? base + half : base;
+        count -= half;
+    }
+    return offsets[base - at.data()];
+}
+
+int64_t MothershipTimeZone::ToUtc(int64_t local) const {
+    // A day either side is past any single transition, whatever the offset.
+    int64_t before = Offset(local - secondsPerDay);
+    int64_t after = Offset(local + secondsPerDay);
+    int64_t early = local - std::max(before, after);
+    int64_t late = local - std::min(before, after);
+    if (Offset(early) == local - early) {
+        return early;
+    }
+    return late;
+}
+
+int64_t MothershipTimeZone::NextTransition(int64_t utc) const {
+    if (utc < first) {
+        return first;
+    }
+    if (utc >= last) {
+        return std::numeric_limits<int64_t>::max();
+    }
+    auto it = std::upper_bound(at.begin(), at.end(), utc);
+    return it == at.end() ? last : *it;
+}
+
+MothershipTimePoint MothershipTimeZone::DayStart(MothershipTimePoint when, int days) const {
+    int64_t day = MothershipFloorDiv(ToLocal(MothershipUnixSeconds(when)), secondsPerDay) + days;
+    return FromSeconds(ToUtc(day * secondsPerDay));
+}
+
+MothershipTimePoint MothershipTimeZone::MonthStart(MothershipTimePoint when, int months) const {
+    int64_t day = MothershipFloorDiv(ToLocal(MothershipUnixSeconds(when)), secondsPerDay);
+    MothershipCivilDate date = MothershipCivilFromDays(day);
+    return DateStart(date.year, date.month + months, 1);
+}
+
+MothershipTimePoint MothershipTimeZone::DateStart(int year, int month, int day) const {
+    int64_t months = static_cast<int64_t>(year) * 12 + (month - 1);
+    int64_t y = MothershipFloorDiv(months, 12);
+    int64_t days = MothershipDaysFromCivil(static_cast<int>(y), static_cast<int>(months - y * 12) + 1, 1) + day - 1;
+    return FromSeconds(ToUtc(days * secondsPerDay));
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mothership_duration.h"
+
+struct MothershipCivilDate {
+    int year;
+    int month; // 1-12
+    int day;   // 1-31
+};
+
+// Proleptic Gregorian calendar on days since 1970-01-01, after Howard
+// Hinnant's chrono-compatible date algorithms: a handful of integer
+// operations, no tables, valid far beyond any session.
+int64_t MothershipDaysFromCivil(int year, int month, int day);
+MothershipCivilDate MothershipCivilFromDays(int64_t days);
+inline int64_t MothershipFloorDiv(int64_t a, int64_t b) {
+    return a / b - ((a % b != 0) & ((a < 0) != (b < 0)));
+}
+// 0 = Monday ... 6 = Sunday.
+inline int MothershipIsoWeekday(int64_t days) {
+    // 1970-01-01 was a Thursday.
+    int64_t weekday = (days + 3) % 7;
+    return static_cast<int>(weekday < 0 ? weekday + 7 : weekday);
+}
+
+// The UTC offsets of a time zone and the instants they change, probed once
+// from the C library so local time needs neither localtime_r nor mktime
+// (which take a global lock and reread TZ state) per call. An offset lookup
+// is a branch-free binary search over the transitions: about 260 for a zone
+// with daylight saving time over the default 130 years.
+//
+// Times outside the table's years fall back to the C library. Offsets are
+// probed a week apart and refined to the second, so a zone that changes and
+// changes back within one week keeps the first offset throughout.
+class MothershipTimeZone {
+public:
+    // The zone of TZ (or /etc/localtime) over [firstYear, lastYear].
+    MothershipTimeZone(int firstYear, int lastYear);
+    // The process's zone for 1970-2100, built on first use; safe to share
+    // between threads once built.
+    static const MothershipTimeZone& Local();
+
+    // Seconds east of UTC in effect at `utc` (seconds since the epoch).
+    int64_t Offset(int64_t utc) const;
+    inline int64_t ToLocal(int64_t utc) const {
+        return utc + Offset(utc);
+    }
+    // The instant a local wall-clock time names, like mktime with tm_isdst
+    // -1: the earlier one when it names two, and for one skipped by a jump
+    // forward the instant counted from the offset before the jump.
+    int64_t ToUtc(int64_t local) const;
+    // The first transition after `utc`, or INT64_MAX when none is known.
+    int64_t NextTransition(int64_t utc) const;
+    inline size_t Transitions() const {
+        return at.size() - 1;
+    }
+
+    // Local midnight starting the day of `when`, moved by `days`.
+    MothershipTimePoint DayStart(MothershipTimePoint when, int days = 0) const;
+    // Local midnight on the first of the month of `when`, moved by `months`.
+    MothershipTimePoint MonthStart(MothershipTimePoint when, int months = 0) const;
+    // Local midnight on a civil date; out-of-range days and months carry over.
+    MothershipTimePoint DateStart(int year, int month, int day) const;
+
+private:
+    std::vector<int64_t> at;      // at[0] is INT64_MIN
+    std::vector<int64_t> offsets; // offsets[i] holds from at[i]
+    int64_t first;
+    int64_t last;
+};
+
+// Whole seconds since the epoch, rounded down.
+inline int64_t MothershipUnixSeconds(MothershipTimePoint when) {
+    return std::chrono::floor<std::chrono::seconds>(when.time_since_epoch()).count();
+}
@@ -0,0 +1,106 @@
+#include "reports/duration_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr size_t linearBuckets = 32;
+constexpr size_t subBuckets = 16;
+
+} // namespace
+
+size_t MothershipDurationHistogram::Bucket(uint64_t millis) {
+    if (millis < linearBuckets) {
+        return static_cast<size_t>(millis);
+    }
+    // Keep the top five bits: v >> shift lands in [16, 32).
+    int shift = 63 - __builtin_clzll(millis) - 4;
+    return linearBuckets + (shift - 1) * subBuckets + static_cast<size_t>((millis >> shift) - subBuckets);
+}
+
+double MothershipDurationHistogram::Middle(size_t bucket) {
+    if (bucket < linearBuckets) {
+        return static_cast<double>(bucket);
+    }
+    size_t shift = (bucket - linearBuckets) / subBuckets + 1;
+    double low = std::ldexp(static_cast<double>(subBuckets + (bucket - linearBuckets) % subBuckets), static_cast<int>(shift));
+    return low + std::ldexp(0.5, static_cast<int>(shift));
+}
+
+void MothershipDurationHistogram::Record(MothershipDuration length) {
+    int64_t millis = std::chrono::duration_cast<std::chrono::milliseconds>(length).count();
+    size_t bucket = Bucket(millis > 0 ? static_cast<uint64_t>(millis) : 0);
+    if (bucket >= counts.size()) {
+        counts.resize(bucket + 1, 0);
+    }
+    counts[bucket] += 1;
+    count += 1;
+}
+
+void MothershipDurationHistogram::Merge(const MothershipDurationHistogram& other) {
+    if (other.counts.size() > counts.size()) {
+        counts.resize(other.counts.size(), 0);
+    }
+    for (size_t i = 0; i < other.counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+}
+
+void MothershipDurationHistogram::Clear() {
+    counts.clear();
+    count = 0;
+}
+
+MothershipDuration MothershipDurationHistogram::Percentile(double p) const {
+    if (count == 0) {
+        return MothershipDuration(0);
+    }
+    p = std::clamp(p, 0.0, 100.0);
+    // Rank of the wanted value, 1-based, as in nearest-rank percentiles.
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100.0 * count)));
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < counts.size(); ++bucket) {
+        seen += counts[bucket];
+        if (seen >= rank) {
+            return std::chrono::round<MothershipDuration>(std::chrono::duration<double, std::milli>(Middle(bucket)));
+        }
+    }
+    return std::chrono::round<MothershipDuration>(std::chrono::duration<double, std::milli>(Middle(counts.size() - 1)));
+}
+
+nlohmann::json MothershipDurationHistogram::ToJson() const {
+    nlohmann::json buckets = nlohmann::json::array();
+    for (size_t i = 0; i < counts.size(); ++i) {
+        if (counts[i]) {
+            buckets.push_back({i, counts[i]});
+        }
+    }
+    return buckets;
+}
+
+bool MothershipDurationHistogram::FromJson(const nlohmann::json& j) {
+    Clear();
+    if (!j.is_array()) {
+        return false;
+    }
+    for (auto& item : j) {
+        if (!item.is_array() || item.size() != 2 || !item[0].is_number_unsigned() || !item[1].is_number_unsigned()) {
+            Clear();
+            return false;
+        }
+        size_t bucket = item[0].get<size_t>();
+        // Beyond the bucket of the largest 64-bit value: not ours.
+        if (bucket > Bucket(UINT64_MAX)) {
+            Clear();
+            return false;
+        }
+        if (bucket >= counts.size()) {
+            counts.resize(bucket + 1, 0);
+        }
+        counts[bucket] += item[1].get<uint64_t>();
+        count += item[1].get<uint64_t>();
+    }
+    return true;
+}
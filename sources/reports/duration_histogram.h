@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "mothership_duration.h"
+
+// Log-linear histogram of durations in milliseconds: exact below 32 ms,
+// then 16 buckets per power of two, so a percentile is within about 3% of
+// the true value. Size depends only on the longest duration recorded (a
+// 4-hour session needs about 350 buckets), not on how many were recorded;
+// histograms merge by adding counts.
+class MothershipDurationHistogram {
+public:
+    void Record(MothershipDuration length);
+    void Merge(const MothershipDurationHistogram& other);
+    void Clear();
+
+    inline uint64_t Count() const {
+        return count;
+    }
+    // The `p`th percentile (0-100), as the middle of its bucket; zero when empty.
+    MothershipDuration Percentile(double p) const;
+
+    // Sparse [[bucket, count], ...].
+    nlohmann::json ToJson() const;
+    bool FromJson(const nlohmann::json& j);
+
+private:
+    static size_t Bucket(uint64_t millis);
+    static double Middle(size_t bucket);
+
+    std::vector<uint64_t> counts;
+    uint64_t count = 0;
+};
@@ -0,0 +1,178 @@
+#include "reports/interval_kernels.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MOTHERSHIP_X86_KERNELS 1
+#endif
+
+namespace {
+
+// Partial results: `shortest` starts at the largest value so lanes merge
+// with a plain min; Finish maps "no overlap" back to zero.
+struct Partial {
+    int64_t overlap = 0;
+    int64_t count = 0;
+    int64_t shortest = std::numeric_limits<int64_t>::max();
+    int64_t longest = 0;
+};
+
+void ClipScalar(Partial& partial, const int64_t* starts, const int64_t* ends, size_t count,
+                int64_t from, int64_t to) {
+    for (size_t i = 0; i < count; ++i) {
+        int64_t length = std::min(ends[i], to) - std::max(starts[i], from);
+        if (length > 0) {
+            partial.overlap += length;
+            partial.count += 1;
+            partial.shortest = std::min(partial.shortest, length);
+            partial.longest = std::max(partial.longest, length);
+        }
+    }
+}
+
+MothershipIntervalStats Finish(const Partial& partial) {
+    MothershipIntervalStats stats;
+    stats.overlap = partial.overlap;
+    stats.count = static_cast<size_t>(partial.count);
+    stats.shortest = partial.count ? partial.shortest : 0;
+    stats.longest = partial.longest;
+    return stats;
+}
+
+#ifdef MOTHERSHIP_X86_KERNELS
+
+// Neither SSE4.2 nor AVX2 has 64-bit min/max; they are compare + blend.
+// pcmpgtq is what rules out plain SSE2.
+
+__attribute__((target("sse4.2")))
+void ClipSse42(Partial& partial, const int64_t* starts, const int64_t* ends, size_t count,
+               int64_t from, int64_t to) {
+    const __m128i vfrom = _mm_set1_epi64x(from);
+    const __m128i vto = _mm_set1_epi64x(to);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i overlap = zero;
+    __m128i hits = zero;
+    __m128i shortest = _mm_set1_epi64x(std::numeric_limits<int64_t>::max());
+    __m128i longest = zero;
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(starts + i));
+        __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ends + i));
+        s = _mm_blendv_epi8(s, vfrom, _mm_cmpgt_epi64(vfrom, s));
+        e = _mm_blendv_epi8(e, vto, _mm_cmpgt_epi64(e, vto));
+        __m128i length = _mm_sub_epi64(e, s);
+        __m128i positive = _mm_cmpgt_epi64(length, zero);
+        overlap = _mm_add_epi64(overlap, _mm_and_si128(length, positive));
+        hits = _mm_sub_epi64(hits, positive);
+        shortest = _mm_blendv_epi8(shortest, length, _mm_and_si128(positive, _mm_cmpgt_epi64(shortest, length)));
+        longest = _mm_blendv_epi8(longest, length, _mm_cmpgt_epi64(length, longest));
+    }
+    alignas(16) int64_t lanes[4][2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes[0]), overlap);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes[1]), hits);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes[2]), shortest);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes[3]), longest);
+    for (int lane = 0; lane < 2; ++lane) {
+        partial.overlap += lanes[0][lane];
+        partial.count += lanes[1][lane];
+        partial.shortest = std::min(partial.shortest, lanes[2][lane]);
+        partial.longest = std::max(partial.longest, lanes[3][lane]);
+    }
+    ClipScalar(partial, starts + i, ends + i, count - i, from, to);
+}
+
+__attribute__((target("avx2")))
+void ClipAvx2(Partial& partial, const int64_t* starts, const int64_t* ends, size_t count,
+              int64_t from, int64_t to) {
+    const __m256i vfrom = _mm256_set1_epi64x(from);
+    const __m256i vto = _mm256_set1_epi64x(to);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i overlap = zero;
+    __m256i hits = zero;
+    __m256i shortest = _mm256_set1_epi64x(std::numeric_limits<int64_t>::max());
+    __m256i longest = zero;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(starts + i));
+        __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ends + i));
+        s = _mm256_blendv_epi8(s, vfrom, _mm256_cmpgt_epi64(vfrom, s));
+        e = _mm256_blendv_epi8(e, vto, _mm256_cmpgt_epi64(e, vto));
+        __m256i length = _mm256_sub_epi64(e, s);
+        __m256i positive = _mm256_cmpgt_epi64(length, zero);
+        overlap = _mm256_add_epi64(overlap, _mm256_and_si256(length, positive));
+        hits = _mm256_sub_epi64(hits, positive);
+        shortest = _mm256_blendv_epi8(shortest, length,
+                                      _mm256_and_si256(positive, _mm256_cmpgt_epi64(shortest, length)));
+        longest = _mm256_blendv_epi8(longest, length, _mm256_cmpgt_epi64(length, longest));
+    }
+    alignas(32) int64_t lanes[4][4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]), overlap);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), hits);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[2]), shortest);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[3]), longest);
+    for (int lane = 0; lane < 4; ++lane) {
+        partial.overlap += lanes[0][lane];
+        partial.count += lanes[1][lane];
+        partial.shortest = std::min(partial.shortest, lanes[2][lane]);
+        partial.longest = std::max(partial.longest, lanes[3][lane]);
+    }
+    ClipScalar(partial, starts + i, ends + i, count - i, from, to);
+}
+
+#endif
+
+MothershipKernelIsa DetectKernel() {
+#ifdef MOTHERSHIP_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return KernelAvx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return KernelSse42;
+    }
+#endif
+    return KernelScalar;
+}
+
+} // namespace
+
+MothershipKernelIsa MothershipBestKernel() {
+    static const MothershipKernelIsa best = DetectKernel();
+    return best;
+}
+
+const char* MothershipKernelName(MothershipKernelIsa isa) {
+    switch (isa) {
+    case KernelAvx2:
+        return "avx2";
+    case KernelSse42:
+        return "sse4.2";
+    default:
+        return "scalar";
+    }
+}
+
+MothershipIntervalStats MothershipClipIntervals(const int64_t* starts, const int64_t* ends, size_t count,
+                                                int64_t from, int64_t to) {
+    return MothershipClipIntervals(MothershipBestKernel(), starts, ends, count, from, to);
+}
+
+MothershipIntervalStats MothershipClipIntervals(MothershipKernelIsa isa, const int64_t* starts, const int64_t* ends,
+                                                size_t count, int64_t from, int64_t to) {
+    Partial partial;
+#ifdef MOTHERSHIP_X86_KERNELS
+    if (isa == KernelAvx2) {
+        ClipAvx2(partial, starts, ends, count, from, to);
+        return Finish(partial);
+    }
+    if (isa == KernelSse42) {
+        ClipSse42(partial, starts, ends, count, from, to);
+        return Finish(partial);
+    }
+#endif
+    (void)isa;
+    ClipScalar(partial, starts, ends, count, from, to);
+    return Finish(partial);
+}
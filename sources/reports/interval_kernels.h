@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// What a set of [start, end) intervals contributes to a window [from, to):
+// the clipped overlap summed, the number of intervals that overlap it and
+// the shortest and longest clipped overlap. Units are those of the inputs.
+struct MothershipIntervalStats {
+    int64_t overlap = 0;
+    size_t count = 0;
+    int64_t shortest = 0;
+    int64_t longest = 0;
+
+    inline bool operator==(const MothershipIntervalStats&) const = default;
+};
+
+enum MothershipKernelIsa {
+    KernelScalar,
+    KernelSse42,
+    KernelAvx2
+};
+
+// The widest kernel this CPU runs, detected once.
+MothershipKernelIsa MothershipBestKernel();
+const char* MothershipKernelName(MothershipKernelIsa isa);
+
+// Clips starts[i], ends[i] against the window with the best kernel.
+MothershipIntervalStats MothershipClipIntervals(const int64_t* starts, const int64_t* ends, size_t count,
+                                                int64_t from, int64_t to);
+// Same with a given kernel, which must be supported; for benchmarks and
+// for checking the vector paths against the scalar one.
+MothershipIntervalStats MothershipClipIntervals(MothershipKernelIsa isa, const int64_t* starts, const int64_t* ends,
+                                                size_t count, int64_t from, int64_t to);
@@ -0,0 +1,86 @@
+#include "reports/month_report.h"
+
+#include <algorithm>
+
+#include "reports/civil_time.h"
+#include "reports/overlap.h"
+
+bool MothershipBuildMonthReport(MothershipData& data, int year, int month, MothershipWorkPool* pool,
+                                MothershipMonthReport& report, MothershipAttribution attribution) {
+    if (month < 1 || month > 12) {
+        return false;
+    }
+    report = MothershipMonthReport();
+    report.year = year;
+    report.month = month;
+
+    // Everything that is not per task is prepared here, on one thread:
+    // day boundaries and the task index, which is built lazily.
+    const MothershipTimeZone& zone = MothershipTimeZone::Local();
+    int64_t monthDays = MothershipDaysFromCivil(year + month / 12, month % 12 + 1, 1) -
+                        MothershipDaysFromCivil(year, month, 1);
+    std::vector<MothershipTimePoint> boundaries;
+    for (int day = 1; day <= monthDays + 1; ++day) {
+        boundaries.push_back(zone.DateStart(year, month, day));
+    }
+    size_t dayCount = boundaries.size() - 1;
+    std::vector<MothershipTask*> tasks(data.TaskCount());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        tasks[i] = &data.TaskAt(i);
+    }
+
+    std::vector<MothershipTaskMonth> results(tasks.size());
+    auto build = [&](size_t index) {
+        MothershipTask& task = *tasks[index];
+        MothershipTaskMonth& result = results[index];
+        result.days.resize(dayCount);
+        for (size_t day = 0; day < dayCount; ++day) {
+            result.days[day] = task.TimeBetween(boundaries[day], boundaries[day + 1]);
+            result.total += result.days[day];
+        }
+        if (result.total.count() > 0) {
+            MothershipIntervalStats stats = task.SessionsBetween(boundaries.front(), boundaries.back());
+            result.sessions = stats.count;
+            result.longest = MothershipDuration(stats.longest);
+            result.title = task.title;
+        }
+    };
+    if (pool) {
+        pool->ParallelFor(tasks.size(), build);
+    } else {
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            build(i);
+        }
+    }
+
+    if (attribution == AttributeProportional) {
+        // One sweep over the month; its tasks are in the same title order.
+        MothershipOverlapReport overlaps;
+        MothershipFindOverlaps(data, boundaries.front(), boundaries.back(), overlaps);
+        for (MothershipTaskMonth& result : results) {
+            std::fill(result.days.begin(), result.days.end(), MothershipDuration(0));
+            result.total = MothershipDuration(0);
+        }
+        for (const MothershipOverlapDay& day : overlaps.days) {
+            size_t index = std::upper_bound(boundaries.begin(), boundaries.end(), day.start) - boundaries.begin() - 1;
+            for (const MothershipOverlapEntry& entry : day.tasks) {
+                MothershipDuration share = std::chrono::round<MothershipDuration>(entry.time.attributed);
+                results[entry.task].days[index] += share;
+                results[entry.task].total += share;
+            }
+        }
+    }
+
+    report.days.assign(dayCount, MothershipDuration(0));
+    for (MothershipTaskMonth& result : results) {
+        if (result.total.count() <= 0) {
+            continue;
+        }
+        report.total += result.total;
+        for (size_t day = 0; day < dayCount; ++day) {
+            report.days[day] += result.days[day];
+        }
+        report.tasks.push_back(std::move(result));
+    }
+    return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "mothership_data.h"
+#include "reports/work_pool.h"
+
+struct MothershipTaskMonth {
+    std::string title;
+    MothershipDuration total{0};
+    // Finished sessions overlapping the month, and the longest part of one
+    // inside it.
+    size_t sessions = 0;
+    MothershipDuration longest{0};
+    // Time per day of the month, local time.
+    std::vector<MothershipDuration> days;
+};
+
+struct MothershipMonthReport {
+    int year = 0;
+    int month = 0;
+    // In title order, tasks without time in the month left out.
+    std::vector<MothershipTaskMonth> tasks;
+    MothershipDuration total{0};
+    std::vector<MothershipDuration> days;
+};
+
+enum MothershipAttribution {
+    // Each task gets all of its time; overlapping tasks count twice.
+    AttributeFull,
+    // Time when tasks ran together is split equally among them, so the
+    // totals add up to wall-clock time (see MothershipFindOverlaps). Each
+    // day's share is rounded to the microsecond.
+    AttributeProportional
+};
+
+// Builds the report for `month` (1-12) of `year`. Tasks are computed in
+// parallel on `pool` when given, each by one thread, and merged in title
+// order, so the result does not depend on the thread count. `data` must not
+// be modified meanwhile.
+bool MothershipBuildMonthReport(MothershipData& data, int year, int month, MothershipWorkPool* pool,
+                                MothershipMonthReport& report, MothershipAttribution attribution = AttributeFull);
@@ -0,0 +1,227 @@
+#include "reports/overlap.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+#include "reports/civil_time.h"
+
+namespace {
+
+typedef MothershipRangeIndex::Ticks Ticks;
+
+// Local midnight starting the day of `ticks`, moved by `days`.
+Ticks LocalMidnight(Ticks ticks, int days) {
+    return MothershipTicks(MothershipTimeZone::Local().DayStart(MothershipFromTicks(ticks), days));
+}
+
+// The sessions of one task inside the window, in start order: its finished
+// ones or its running one.
+struct Stream {
+    size_t task;
+    const MothershipRangeIndex* sessions;
+    size_t next;
+    size_t end;
+    Ticks runningStart;
+    Ticks runningEnd;
+};
+
+// Exact parts in ticks; attributed in seconds, since it divides.
+struct Accumulator {
+    Ticks exclusive = 0;
+    Ticks overlapped = 0;
+    double attributed = 0.0;
+
+    MothershipOverlapTime Time() const {
+        MothershipOverlapTime time;
+        time.exclusive = MothershipDuration(exclusive);
+        time.overlapped = MothershipDuration(overlapped);
+        time.attributed = std::chrono::duration<double>(attributed);
+        return time;
+    }
+};
+
+} // namespace
+
+void MothershipFindOverlaps(MothershipData& data, MothershipTimePoint from, MothershipTimePoint to,
+                            MothershipOverlapReport& report) {
+    report = MothershipOverlapReport();
+    size_t taskCount = data.TaskCount();
+    report.tasks.resize(taskCount);
+    for (size_t i = 0; i < taskCount; ++i) {
+        report.tasks[i] = &data.TaskAt(i);
+    }
+    report.totals.resize(taskCount);
+    Ticks a = MothershipTicks(from);
+    Ticks b = MothershipTicks(to);
+    if (a >= b) {
+        return;
+    }
+    Ticks now = MothershipTicks(MothershipNow());
+
+    std::vector<Stream> streams;
+    for (size_t i = 0; i < taskCount; ++i) {
+        MothershipTask& task = *report.tasks[i];
+        const MothershipRangeIndex& sessions = task.FinishedSessions();
+        size_t first, last;
+        sessions.Touching(a, b, first, last);
+        if (first < last) {
+            streams.push_back(Stream{i, &sessions, first, last, 0, 0});
+        }
+        if (task.Started()) {
+            Ticks start = MothershipTicks(task.timeFrames[task.currentTimeframe].startTime);
+            streams.push_back(Stream{i, nullptr, 0, 1, start, now});
+        }
+    }
+
+    // Pulls the next session of a stream that overlaps the window.
+    auto pull = [&](Stream& stream, Ticks& start, Ticks& end) {
+        while (stream.next < stream.end) {
+            size_t at = stream.next++;
+            start = std::max(a, stream.sessions ? stream.sessions->Start(at) : stream.runningStart);
+            end = std::min(b, stream.sessions ? stream.sessions->End(at) : stream.runningEnd);
+            if (start < end) {
+                return true;
+            }
+        }
+        return false;
+    };
+    typedef std::pair<Ticks, size_t> Event;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> starts;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> ends;
+    // Next session of each stream, waiting for its start.
+    std::vector<Ticks> pendingEnd(streams.size());
+    for (size_t s = 0; s < streams.size(); ++s) {
+        Ticks start;
+        if (pull(streams[s], start, pendingEnd[s])) {
+            starts.push(Event{start, s});
+        }
+    }
+    if (starts.empty()) {
+        return;
+    }
+
+    // Running integrals over the sweep: wall-clock time with two or more
+    // tasks active, and the share 1/m of each instant with m tasks active.
+    // A task's overlapped and attributed time over a stretch is the
+    // difference of these between its ends, so a segment costs O(1) however
+    // many tasks are active; only midnights settle every active task.
+    Ticks overlapClock = 0;
+    double shareClock = 0.0;
+    Ticks covered = 0;
+    double tracked = 0.0;
+
+    struct Mark {
+        Ticks at;
+        Ticks overlap;
+        double share;
+    };
+    std::vector<int> open(taskCount, 0);
+    std::vector<Mark> marks(taskCount);
+    size_t activeCount = 0;
+    std::vector<size_t> active;
+    std::vector<size_t> position(taskCount, 0);
+
+    std::vector<Accumulator> totals(taskCount);
+    std::vector<Accumulator> today(taskCount);
+    std::vector<size_t> touched;
+    auto settle = [&](size_t task, Ticks t) {
+        Mark& mark = marks[task];
+        Ticks length = t - mark.at;
+        if (length > 0) {
+            if (today[task].exclusive == 0 && today[task].overlapped == 0) {
+                touched.push_back(task);
+            }
+            Ticks overlap = overlapClock - mark.overlap;
+            for (Accumulator* sum : {&totals[task], &today[task]}) {
+                sum->exclusive += length - overlap;
+                sum->overlapped += overlap;
+                sum->attributed += shareClock - mark.share;
+            }
+        }
+        mark = Mark{t, overlapClock, shareClock};
+    };
+
+    Ticks t = starts.top().first;
+    Ticks dayStart = LocalMidnight(t, 0);
+    Ticks midnight = LocalMidnight(t, 1);
+    auto flushDay = [&]() {
+        for (size_t task : active) {
+            settle(task, midnight);
+        }
+        if (touched.empty()) {
+            return;
+        }
+        std::sort(touched.begin(), touched.end());
+        MothershipOverlapDay day;
+        day.start = MothershipFromTicks(dayStart);
+        for (size_t task : touched) {
+            day.tasks.push_back(MothershipOverlapEntry{task, today[task].Time()});
+            today[task] = Accumulator();
+        }
+        report.days.push_back(std::move(day));
+        touched.clear();
+    };
+
+    while (!starts.empty() || !ends.empty()) {
+        Ticks next = std::min(starts.empty() ? b : starts.top().first, ends.empty() ? b : ends.top().first);
+        if (activeCount == 0 && next >= midnight) {
+            // Idle across midnight: skip straight to the day of the next start.
+            flushDay();
+            dayStart = LocalMidnight(next, 0);
+            midnight = LocalMidnight(next, 1);
+        }
+        next = std::min(next, midnight);
+        if (activeCount > 0 && next > t) {
+            Ticks length = next - t;
+            double seconds = MothershipSeconds(MothershipDuration(length));
+            covered += length;
+            overlapClock += activeCount > 1 ? length : 0;
+            shareClock += seconds / activeCount;
+            tracked += seconds * activeCount;
+        }
+        t = next;
+        if (t == midnight) {
+            flushDay();
+            dayStart = midnight;
+            midnight = LocalMidnight(midnight, 1);
+        }
+        // Half-open sessions: close before opening at the same instant.
+        while (!ends.empty() && ends.top().first == t) {
+            size_t task = ends.top().second;
+            ends.pop();
+            if (--open[task] == 0) {
+                settle(task, t);
+                activeCount -= 1;
+                size_t at = position[task];
+                active[at] = active.back();
+                position[active[at]] = at;
+                active.pop_back();
+            }
+        }
+        while (!starts.empty() && starts.top().first == t) {
+            size_t s = starts.top().second;
+            starts.pop();
+            size_t task = streams[s].task;
+            if (open[task]++ == 0) {
+                marks[task] = Mark{t, overlapClock, shareClock};
+                activeCount += 1;
+                position[task] = active.size();
+                active.push_back(task);
+            }
+            ends.push(Event{pendingEnd[s], task});
+            Ticks start;
+            if (pull(streams[s], start, pendingEnd[s])) {
+                starts.push(Event{start, s});
+            }
+        }
+    }
+    flushDay();
+
+    for (size_t i = 0; i < taskCount; ++i) {
+        report.totals[i] = totals[i].Time();
+    }
+    report.tracked = std::chrono::duration<double>(tracked);
+    report.covered = MothershipDuration(covered);
+    report.overlapped = MothershipDuration(overlapClock);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "mothership_data.h"
+
+struct MothershipOverlapTime {
+    // While no other task was running.
+    MothershipDuration exclusive{0};
+    // While at least one other task was running too.
+    MothershipDuration overlapped{0};
+    // Exclusive time plus an equal share of each overlap; summed over tasks
+    // it gives wall-clock time. Fractional, since shares divide.
+    std::chrono::duration<double> attributed{0};
+};
+
+struct MothershipOverlapEntry {
+    // Index into MothershipOverlapReport::tasks.
+    size_t task;
+    MothershipOverlapTime time;
+};
+
+struct MothershipOverlapDay {
+    // Local midnight.
+    MothershipTimePoint start;
+    // Tasks with time that day, in title order.
+    std::vector<MothershipOverlapEntry> tasks;
+};
+
+struct MothershipOverlapReport {
+    // Every task, in title order; totals[i] belongs to tasks[i].
+    std::vector<MothershipTask*> tasks;
+    std::vector<MothershipOverlapTime> totals;
+    // Days with any time, in order.
+    std::vector<MothershipOverlapDay> days;
+    // Summed over tasks, so overlaps count once per task.
+    std::chrono::duration<double> tracked{0};
+    // Wall-clock time with at least one task running, and with two or more.
+    MothershipDuration covered{0};
+    MothershipDuration overlapped{0};
+};
+
+// Sweeps every task's sessions inside [from, to), running ones up to now,
+// and splits each task's time into exclusive and overlapped. The tasks'
+// sorted sessions are merged with two heaps (next start per task, ends of
+// the running intervals): O(n log k) for n sessions of k tasks, plus the
+// tasks active in each segment. Sessions of one task that overlap each
+// other count once.
+void MothershipFindOverlaps(MothershipData& data, MothershipTimePoint from, MothershipTimePoint to,
+                            MothershipOverlapReport& report);
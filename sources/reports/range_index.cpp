@@ -0,0 +1,119 @@
+#include "reports/range_index.h"
+
+#include <algorithm>
+#include <numeric>
+
+void MothershipRangeIndex::Clear() {
+    starts.clear();
+    ends.clear();
+    cumulative.assign(1, 0);
+    maxEnd.clear();
+}
+
+bool MothershipRangeIndex::Append(TimePoint start, TimePoint end) {
+    Ticks s = MothershipTicks(start);
+    Ticks e = MothershipTicks(end);
+    if (!starts.empty() && s < starts.back()) {
+        return false;
+    }
+    starts.push_back(s);
+    ends.push_back(e);
+    cumulative.push_back(cumulative.back() + (e - s));
+    maxEnd.push_back(maxEnd.empty() ? e : std::max(maxEnd.back(), e));
+    return true;
+}
+
+void MothershipRangeIndex::Insert(TimePoint start, TimePoint end) {
+    starts.push_back(MothershipTicks(start));
+    ends.push_back(MothershipTicks(end));
+}
+
+void MothershipRangeIndex::Finish() {
+    std::vector<size_t> order(starts.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) { return starts[a] < starts[b]; });
+    std::vector<Ticks> sortedStarts(starts.size());
+    std::vector<Ticks> sortedEnds(ends.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        sortedStarts[i] = starts[order[i]];
+        sortedEnds[i] = ends[order[i]];
+    }
+    starts = std::move(sortedStarts);
+    ends = std::move(sortedEnds);
+    cumulative.assign(1, 0);
+    cumulative.reserve(starts.size() + 1);
+    maxEnd.clear();
+    maxEnd.reserve(starts.size());
+    for (size_t i = 0; i < starts.size(); ++i) {
+        cumulative.push_back(cumulative.back() + (ends[i] - starts[i]));
+        maxEnd.push_back(i == 0 ? ends[i] : std::max(maxEnd.back(), ends[i]));
+    }
+}
+
+void MothershipRangeIndex::Touching(Ticks from, Ticks to, size_t& first, size_t& last) const {
+    first = std::upper_bound(maxEnd.begin(), maxEnd.end(), from) - maxEnd.begin();
+    last = std::lower_bound(starts.begin(), starts.end(), to) - starts.begin();
+}
+
+MothershipDuration MothershipRangeIndex::Total(TimePoint from, TimePoint to) const {
+    Ticks a = MothershipTicks(from);
+    Ticks b = MothershipTicks(to);
+    if (a >= b || starts.empty()) {
+        return MothershipDuration(0);
+    }
+    size_t first, last;
+    Touching(a, b, first, last);
+    if (first >= last) {
+        return MothershipDuration(0);
+    }
+    Ticks total = cumulative[last] - cumulative[first];
+    // Left edge: intervals in range that start before `a` (without overlaps
+    // there is at most one). One that also ends before `a` cancels out.
+    for (size_t i = first; i < last && starts[i] < a; ++i) {
+        total -= std::min(ends[i], a) - starts[i];
+    }
+    // Right edge: only intervals at or after the first whose running
+    // maximum passes `b` can end after it.
+    size_t tail = std::upper_bound(maxEnd.begin() + first, maxEnd.begin() + last, b) - maxEnd.begin();
+    for (size_t i = tail; i < last; ++i) {
+        if (ends[i] > b) {
+            total -= ends[i] - std::max(starts[i], b);
+        }
+    }
+    return MothershipDuration(total);
+}
+
+MothershipIntervalStats MothershipRangeIndex::Stats(TimePoint from, TimePoint to) const {
+    Ticks a = MothershipTicks(from);
+    Ticks b = MothershipTicks(to);
+    if (a >= b || starts.empty()) {
+        return MothershipIntervalStats();
+    }
+    size_t first, last;
+    Touching(a, b, first, last);
+    if (first >= last) {
+        return MothershipIntervalStats();
+    }
+    return MothershipClipIntervals(starts.data() + first, ends.data() + first, last - first, a, b);
+}
+
+void MothershipRangeIndex::Split(const std::vector<Ticks>& edges, std::vector<Ticks>& perBucket) const {
+    perBucket.assign(edges.size() < 2 ? 0 : edges.size() - 1, 0);
+    if (perBucket.empty()) {
+        return;
+    }
+    // Both sides are sorted, so the bucket only moves forward.
+    size_t bucket = 0;
+    for (size_t i = 0; i < starts.size(); ++i) {
+        Ticks s = std::max(starts[i], edges.front());
+        Ticks e = std::min(ends[i], edges.back());
+        while (bucket + 1 < perBucket.size() && edges[bucket + 1] <= s) {
+            ++bucket;
+        }
+        for (size_t b = bucket; s < e; ++b) {
+            Ticks piece = std::min(e, edges[b + 1]) - s;
+            perBucket[b] += piece;
+            s += piece;
+        }
+    }
+}
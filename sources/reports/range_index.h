@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "mothership_duration.h"
+#include "reports/interval_kernels.h"
+
+// Closed intervals sorted by start, with the cumulative duration before each
+// one. The total inside any window [from, to) is two binary searches for
+// the intervals touching it, one subtraction, and clipping of the intervals
+// that straddle an edge.
+//
+// Overlapping intervals (possible after a merge) are counted once each, as
+// in MothershipTask::CalculateTotalTime.
+class MothershipRangeIndex {
+public:
+    typedef MothershipTimePoint TimePoint;
+    // Microseconds since the epoch, see MothershipTicks.
+    typedef int64_t Ticks;
+
+    void Clear();
+    // Intervals appended in start order keep the index valid; returns false
+    // when `start` precedes the last one and the index must be rebuilt.
+    bool Append(TimePoint start, TimePoint end);
+    // Sorts the intervals added with Insert; Append needs no Finish.
+    void Insert(TimePoint start, TimePoint end);
+    void Finish();
+
+    MothershipDuration Total(TimePoint from, TimePoint to) const;
+    // Count and shortest/longest clipped session in the window, in ticks;
+    // scans only the intervals the window touches, with the SIMD kernels.
+    MothershipIntervalStats Stats(TimePoint from, TimePoint to) const;
+    inline size_t Size() const {
+        return starts.size();
+    }
+    // Summed length of all intervals.
+    inline Ticks Sum() const {
+        return cumulative.back();
+    }
+    // Earliest start and latest end; the index must not be empty.
+    inline Ticks First() const {
+        return starts.front();
+    }
+    inline Ticks Last() const {
+        return maxEnd.back();
+    }
+    // [first, last): intervals starting before `to` and not ending by `from`
+    // (with overlaps, some inside may still end by `from`).
+    void Touching(Ticks from, Ticks to, size_t& first, size_t& last) const;
+    inline Ticks Start(size_t index) const {
+        return starts[index];
+    }
+    inline Ticks End(size_t index) const {
+        return ends[index];
+    }
+    // Length inside each bucket [edges[i], edges[i + 1]) into perBucket[i].
+    void Split(const std::vector<Ticks>& edges, std::vector<Ticks>& perBucket) const;
+
+private:
+
+    std::vector<Ticks> starts;
+    std::vector<Ticks> ends;
+    // cumulative[i]: summed length of intervals [0, i); one longer than starts.
+    std::vector<Ticks> cumulative{0};
+    // maxEnd[i]: latest end among intervals [0, i]; non-decreasing, so
+    // the intervals ending before a point form a prefix.
+    std::vector<Ticks> maxEnd;
+};
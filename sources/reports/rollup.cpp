@@ -0,0 +1,95 @@
+#include "reports/rollup.h"
+
+#include <algorithm>
+
+#include "reports/civil_time.h"
+
+namespace {
+
+// The keys of every kind for local time `local`, in seconds since the
+// local epoch.
+void KeysOf(int64_t local, int64_t keys[BucketKinds]) {
+    int64_t days = MothershipFloorDiv(local, 86400);
+    MothershipCivilDate date = MothershipCivilFromDays(days);
+    int64_t day = static_cast<int64_t>(date.year) * 10000 + date.month * 100 + date.day;
+    keys[BucketHour] = day * 100 + (local - days * 86400) / 3600;
+    keys[BucketDay] = day;
+    keys[BucketMonth] = day / 100;
+    // An ISO week belongs to the year of its Thursday.
+    int64_t thursday = days - MothershipIsoWeekday(days) + 3;
+    int year = MothershipCivilFromDays(thursday).year;
+    keys[BucketWeek] = static_cast<int64_t>(year) * 100 + (thursday - MothershipDaysFromCivil(year, 1, 1)) / 7 + 1;
+}
+
+} // namespace
+
+int64_t MothershipRollup::Key(MothershipBucketKind kind, TimePoint when) {
+    int64_t keys[BucketKinds];
+    KeysOf(MothershipTimeZone::Local().ToLocal(MothershipUnixSeconds(when)), keys);
+    return keys[kind];
+}
+
+void MothershipRollup::Clear() {
+    for (_Buckets& list : buckets) {
+        list.clear();
+    }
+}
+
+void MothershipRollup::AddTo(MothershipBucketKind kind, int64_t key, MothershipDuration time) {
+    _Buckets& list = buckets[kind];
+    // Sessions mostly close in time order: the bucket is usually the last one.
+    if (!list.empty() && list.back().key == key) {
+        list.back().time += time;
+        return;
+    }
+    auto it = std::lower_bound(list.begin(), list.end(), key, [](const Bucket& b, int64_t k) { return b.key < k; });
+    if (it != list.end() && it->key == key) {
+        it->time += time;
+    } else {
+        list.insert(it, Bucket{key, time});
+    }
+}
+
+void MothershipRollup::Add(TimePoint start, TimePoint end) {
+    const MothershipTimeZone& zone = MothershipTimeZone::Local();
+    const int64_t perSecond = 1000000;
+    int64_t from = MothershipTicks(start);
+    int64_t to = MothershipTicks(end);
+    while (from < to) {
+        int64_t second = MothershipFloorDiv(from, perSecond);
+        int64_t local = zone.ToLocal(second);
+        // Up to the next local hour boundary, or the next offset change,
+        // after which local hours are counted from the new offset.
+        int64_t boundary = second + 3600 - (local - MothershipFloorDiv(local, 3600) * 3600);
+        boundary = std::min(boundary, zone.NextTransition(second));
+        int64_t pieceEnd = std::min(to, boundary * perSecond);
+        int64_t keys[BucketKinds];
+        KeysOf(local, keys);
+        for (int kind = 0; kind < BucketKinds; ++kind) {
+            AddTo(static_cast<MothershipBucketKind>(kind), keys[kind], MothershipDuration(pieceEnd - from));
+        }
+        from = pieceEnd;
+    }
+}
+
+void MothershipRollup::Merge(const MothershipRollup& other) {
+    for (int kind = 0; kind < BucketKinds; ++kind) {
+        for (const Bucket& bucket : other.buckets[kind]) {
+            AddTo(static_cast<MothershipBucketKind>(kind), bucket.key, bucket.time);
+        }
+    }
+}
+
+MothershipDuration MothershipRollup::Total(MothershipBucketKind kind, int64_t key) const {
+    return Sum(kind, key, key);
+}
+
+MothershipDuration MothershipRollup::Sum(MothershipBucketKind kind, int64_t fromKey, int64_t toKey) const {
+    const _Buckets& list = buckets[kind];
+    auto it = std::lower_bound(list.begin(), list.end(), fromKey, [](const Bucket& b, int64_t k) { return b.key < k; });
+    MothershipDuration sum(0);
+    for (; it != list.end() && it->key <= toKey; ++it) {
+        sum += it->time;
+    }
+    return sum;
+}
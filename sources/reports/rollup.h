@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "mothership_duration.h"
+
+enum MothershipBucketKind {
+    BucketHour,
+    BucketDay,
+    BucketWeek, // ISO 8601
+    BucketMonth,
+    BucketKinds
+};
+
+// Closed time per local-time bucket: hour, day, ISO week and
+// month. An interval is split at local hour boundaries as it is added, so a
+// total over a bucket (or a range of buckets) is a lookup, independent of
+// how many sessions contributed.
+//
+// Bucket keys are the civil labels packed into integers, ordered in time:
+// hour YYYYMMDDHH, day YYYYMMDD, week YYYYWW (ISO year), month YYYYMM.
+class MothershipRollup {
+public:
+    typedef MothershipTimePoint TimePoint;
+
+    struct Bucket {
+        int64_t key;
+        MothershipDuration time;
+    };
+    typedef std::vector<Bucket> _Buckets;
+
+    void Add(TimePoint start, TimePoint end);
+    void Merge(const MothershipRollup& other);
+    void Clear();
+
+    MothershipDuration Total(MothershipBucketKind kind, int64_t key) const;
+    // Sum over keys in [fromKey, toKey]; O(log n + buckets in range).
+    MothershipDuration Sum(MothershipBucketKind kind, int64_t fromKey, int64_t toKey) const;
+    inline const _Buckets& Buckets(MothershipBucketKind kind) const {
+        return buckets[kind];
+    }
+    inline bool Empty() const {
+        return buckets[BucketHour].empty();
+    }
+
+    // The key of the `kind` bucket containing `when`, in local time.
+    static int64_t Key(MothershipBucketKind kind, TimePoint when);
+
+private:
+    void AddTo(MothershipBucketKind kind, int64_t key, MothershipDuration time);
+
+    _Buckets buckets[BucketKinds];
+};
@@ -0,0 +1,82 @@
+#include "reports/time_bounds.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "mothership_data.h"
+#include "reports/civil_time.h"
+
+namespace {
+
+// Local midnight on the first of the month containing `when`, moved by
+// `months`.
+MothershipRangeIndex::Ticks MonthStart(MothershipRangeIndex::Ticks when, int months) {
+    return MothershipTicks(MothershipTimeZone::Local().MonthStart(MothershipFromTicks(when), months));
+}
+
+} // namespace
+
+void MothershipTimeBounds::Build(const std::vector<MothershipTask*>& tasks) {
+    lifetime.clear();
+    lifetime.reserve(tasks.size());
+    months.clear();
+    edges.clear();
+    stale.clear();
+    erased.clear();
+
+    MothershipRangeIndex::Ticks earliest = std::numeric_limits<MothershipRangeIndex::Ticks>::max();
+    MothershipRangeIndex::Ticks latest = std::numeric_limits<MothershipRangeIndex::Ticks>::min();
+    for (MothershipTask* task : tasks) {
+        const MothershipRangeIndex& sessions = task->FinishedSessions();
+        lifetime.push_back(Bound{task, sessions.Sum()});
+        if (sessions.Size()) {
+            earliest = std::min(earliest, sessions.First());
+            latest = std::max(latest, sessions.Last());
+        }
+    }
+    std::make_heap(lifetime.begin(), lifetime.end(), [](const Bound& a, const Bound& b) { return a.ticks < b.ticks; });
+    if (earliest > latest) {
+        return;
+    }
+
+    for (MothershipRangeIndex::Ticks edge = MonthStart(earliest, 0); edge <= latest; edge = MonthStart(edge, 1)) {
+        edges.push_back(edge);
+    }
+    edges.push_back(MonthStart(edges.back(), 1));
+    months.resize(edges.size() - 1);
+    std::vector<MothershipRangeIndex::Ticks> perMonth;
+    for (MothershipTask* task : tasks) {
+        task->FinishedSessions().Split(edges, perMonth);
+        for (size_t month = 0; month < perMonth.size(); ++month) {
+            if (perMonth[month] > 0) {
+                months[month].push_back(Bound{task, perMonth[month]});
+            }
+        }
+    }
+}
+
+void MothershipTimeBounds::Add(MothershipTask* task) {
+    // A new task can take the address of an erased one; the old entries are
+    // then too high for it, which a bound may be.
+    erased.erase(task);
+    lifetime.push_back(Bound{task, 0});
+    std::push_heap(lifetime.begin(), lifetime.end(), [](const Bound& a, const Bound& b) { return a.ticks < b.ticks; });
+}
+
+void MothershipTimeBounds::Erase(MothershipTask* task) {
+    erased.insert(task);
+    stale.erase(std::remove(stale.begin(), stale.end(), task), stale.end());
+}
+
+bool MothershipTimeBounds::Months(TimePoint from, TimePoint to, size_t& first, size_t& last) const {
+    MothershipRangeIndex::Ticks a = MothershipTicks(from);
+    MothershipRangeIndex::Ticks b = MothershipTicks(to);
+    if (months.empty() || a >= b || b <= edges.front() || a >= edges.back()) {
+        return false;
+    }
+    first = std::upper_bound(edges.begin(), edges.end(), a) - edges.begin();
+    first = first == 0 ? 0 : first - 1;
+    last = std::lower_bound(edges.begin(), edges.end(), b) - edges.begin();
+    last = std::min(last, months.size());
+    return first < last;
+}
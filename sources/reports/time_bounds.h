@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "reports/range_index.h"
+
+class MothershipTask;
+
+// Upper bounds on how much time each task can have in a window, for
+// top-K queries that must not score every task:
+//
+//   - every task with its finished time, as a binary max-heap (built in
+//     O(n), never sorted); good for long windows;
+//   - per local calendar month, the tasks with finished time in it and how
+//     much; a short window only needs the tasks of the months it touches.
+//
+// Bounds are taken when built. Tasks added since get a zero bound; tasks
+// stopped since are listed as stale and their bounds may be too low;
+// running tasks' bounds leave out the running session. Erased tasks keep
+// their entries until the next build, and Live() tells them apart.
+class MothershipTimeBounds {
+public:
+    typedef MothershipTimePoint TimePoint;
+
+    struct Bound {
+        MothershipTask* task;
+        int64_t ticks;
+    };
+    typedef std::vector<Bound> _Bounds;
+
+    void Build(const std::vector<MothershipTask*>& tasks);
+    inline void MarkStale(MothershipTask* task) {
+        stale.push_back(task);
+    }
+    void Add(MothershipTask* task);
+    // Before `task` is destroyed; its entries are not to be dereferenced.
+    void Erase(MothershipTask* task);
+    inline bool Live(MothershipTask* task) const {
+        return erased.empty() || erased.find(task) == erased.end();
+    }
+    inline size_t Erased() const {
+        return erased.size();
+    }
+
+    inline const _Bounds& Lifetime() const {
+        return lifetime;
+    }
+    // Months overlapping [from, to) as [first, last); false if none.
+    bool Months(TimePoint from, TimePoint to, size_t& first, size_t& last) const;
+    inline const _Bounds& Month(size_t index) const {
+        return months[index];
+    }
+    inline const std::vector<MothershipTask*>& Stale() const {
+        return stale;
+    }
+
+private:
+    _Bounds lifetime;
+    // edges[i] starts months[i]; one edge more than months.
+    std::vector<MothershipRangeIndex::Ticks> edges;
+    std::vector<_Bounds> months;
+    std::vector<MothershipTask*> stale;
+    std::unordered_set<MothershipTask*> erased;
+};
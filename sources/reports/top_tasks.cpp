@@ -0,0 +1,114 @@
+#include "reports/top_tasks.h"
+
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+// Orders the bounded heap so its top is the weakest of the best k.
+struct Weaker {
+    bool operator()(const MothershipTaskTime& a, const MothershipTaskTime& b) const {
+        if (a.time != b.time) {
+            return a.time > b.time;
+        }
+        return a.task->title < b.task->title;
+    }
+};
+
+} // namespace
+
+size_t MothershipTopTasks(MothershipData& data, MothershipTimePoint from, MothershipTimePoint to, size_t k,
+                          std::vector<MothershipTaskTime>& top) {
+    top.clear();
+    if (k == 0 || from >= to) {
+        return 0;
+    }
+    const MothershipTimeBounds& bounds = data.TimeBounds();
+    std::priority_queue<MothershipTaskTime, std::vector<MothershipTaskTime>, Weaker> best;
+    size_t evaluated = 0;
+    std::unordered_set<MothershipTask*> seen;
+    auto consider = [&](MothershipTask* task) {
+        if (!bounds.Live(task) || !seen.insert(task).second) {
+            return;
+        }
+        evaluated += 1;
+        MothershipTaskTime entry{task, task->TimeBetween(from, to)};
+        if (entry.time.count() <= 0) {
+            return;
+        }
+        if (best.size() < k) {
+            best.push(entry);
+        } else if (Weaker()(entry, best.top())) {
+            best.pop();
+            best.push(entry);
+        }
+    };
+    // Ties go to the earlier title, so a bound equal to the k-th can still win.
+    MothershipDuration window = std::chrono::ceil<MothershipDuration>(to - from);
+    auto hopeless = [&](int64_t ticks) {
+        return best.size() == k && std::min(MothershipDuration(ticks), window) < best.top().time;
+    };
+
+    for (MothershipTask* task : data.RunningTasks()) {
+        consider(task);
+    }
+    for (MothershipTask* task : bounds.Stale()) {
+        consider(task);
+    }
+
+    auto byTicks = [](const MothershipTimeBounds::Bound& a, const MothershipTimeBounds::Bound& b) {
+        return a.ticks < b.ticks;
+    };
+    size_t first, last;
+    if (bounds.Months(from, to, first, last) && last - first <= 3) {
+        // Short window: only tasks with time in its months can have any,
+        // and their time in those months bounds it.
+        MothershipTimeBounds::_Bounds candidates;
+        if (last - first == 1) {
+            candidates = bounds.Month(first);
+        } else {
+            std::unordered_map<MothershipTask*, int64_t> sums;
+            for (size_t month = first; month < last; ++month) {
+                for (const MothershipTimeBounds::Bound& bound : bounds.Month(month)) {
+                    sums[bound.task] += bound.ticks;
+                }
+            }
+            candidates.reserve(sums.size());
+            for (auto& [task, ticks] : sums) {
+                candidates.push_back(MothershipTimeBounds::Bound{task, ticks});
+            }
+        }
+        std::make_heap(candidates.begin(), candidates.end(), byTicks);
+        while (!candidates.empty() && !hopeless(candidates.front().ticks)) {
+            std::pop_heap(candidates.begin(), candidates.end(), byTicks);
+            consider(candidates.back().task);
+            candidates.pop_back();
+        }
+    } else {
+        // Long window: walk the lifetime heap from its root, always expanding
+        // the node with the largest bound. Children never have larger bounds,
+        // so once the frontier's best is hopeless, everything left is.
+        const MothershipTimeBounds::_Bounds& lifetime = bounds.Lifetime();
+        auto lessBound = [&](size_t a, size_t b) { return lifetime[a].ticks < lifetime[b].ticks; };
+        std::priority_queue<size_t, std::vector<size_t>, decltype(lessBound)> frontier(lessBound);
+        if (!lifetime.empty()) {
+            frontier.push(0);
+        }
+        while (!frontier.empty() && !hopeless(lifetime[frontier.top()].ticks)) {
+            size_t node = frontier.top();
+            frontier.pop();
+            consider(lifetime[node].task);
+            for (size_t child = 2 * node + 1; child <= 2 * node + 2 && child < lifetime.size(); ++child) {
+                frontier.push(child);
+            }
+        }
+    }
+
+    top.resize(best.size());
+    for (size_t i = top.size(); i-- > 0;) {
+        top[i] = best.top();
+        best.pop();
+    }
+    return evaluated;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "mothership_data.h"
+
+struct MothershipTaskTime {
+    MothershipTask* task;
+    MothershipDuration time;
+};
+
+// The `k` tasks with the most time inside [from, to), most first; ties in
+// title order, tasks without time left out.
+//
+// Candidates are visited in order of an upper bound on their time (see
+// MothershipTimeBounds), keeping the best k in a bounded heap, and the walk
+// stops once no remaining bound can beat the k-th. Windows within three
+// calendar months use the month bounds, longer ones the lifetime heap.
+// Running tasks and those with stale bounds are scored first. Returns how
+// many tasks were scored.
+size_t MothershipTopTasks(MothershipData& data, MothershipTimePoint from, MothershipTimePoint to, size_t k,
+                          std::vector<MothershipTaskTime>& top);
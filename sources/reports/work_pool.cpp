@@ -0,0 +1,126 @@
+#include "reports/work_pool.h"
+
+MothershipWorkPool::MothershipWorkPool(unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (unsigned i = 1; i < threads; ++i) {
+        workers.emplace_back([this, i] { WorkerLoop(i); });
+    }
+}
+
+MothershipWorkPool::~MothershipWorkPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void MothershipWorkPool::ParallelFor(size_t count, const std::function<void(size_t)>& job) {
+    if (count == 0) {
+        return;
+    }
+    if (workers.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            job(i);
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->job = &job;
+        size_t share = (count + queues.size() - 1) / queues.size();
+        for (size_t q = 0, begin = 0; q < queues.size() && begin < count; ++q, begin += share) {
+            std::lock_guard<std::mutex> queueLock(queues[q]->mutex);
+            queues[q]->ranges.push_back(Range{begin, std::min(count, begin + share)});
+        }
+        remaining = count;
+        generation += 1;
+    }
+    wake.notify_all();
+    Drain(0);
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return remaining == 0 && busy == 0; });
+}
+
+void MothershipWorkPool::WorkerLoop(unsigned self) {
+    unsigned long long seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = generation;
+        busy += 1;
+        lock.unlock();
+        Drain(self);
+        lock.lock();
+        busy -= 1;
+        if (busy == 0 && remaining == 0) {
+            done.notify_all();
+        }
+    }
+}
+
+void MothershipWorkPool::Drain(unsigned self) {
+    Range range;
+    while (Take(self, range) || Steal(self, range)) {
+        // One index at a time; the rest goes back where thieves can see it.
+        size_t index = range.begin++;
+        if (range.begin < range.end) {
+            std::lock_guard<std::mutex> lock(queues[self]->mutex);
+            queues[self]->ranges.push_back(range);
+        }
+        (*job)(index);
+        Finished(1);
+    }
+}
+
+bool MothershipWorkPool::Take(unsigned self, Range& range) {
+    Queue& queue = *queues[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.ranges.empty()) {
+        return false;
+    }
+    range = queue.ranges.back();
+    queue.ranges.pop_back();
+    return true;
+}
+
+bool MothershipWorkPool::Steal(unsigned self, Range& range) {
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        Queue& victim = *queues[(self + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.ranges.empty()) {
+            continue;
+        }
+        Range& theirs = victim.ranges.front();
+        size_t half = (theirs.end - theirs.begin) / 2;
+        if (half == 0) {
+            range = theirs;
+            victim.ranges.pop_front();
+        } else {
+            range = Range{theirs.end - half, theirs.end};
+            theirs.end -= half;
+        }
+        return true;
+    }
+    return false;
+}
+
+void MothershipWorkPool::Finished(size_t items) {
+    if (remaining.fetch_sub(items) == items) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (busy == 0) {
+            done.notify_all();
+        }
+    }
+}
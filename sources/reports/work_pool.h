@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. Each ParallelFor
+// deals the index range out in contiguous blocks, one queue per thread;
+// a thread that runs dry steals half of the largest remaining range from
+// another queue. The calling thread works too.
+class MothershipWorkPool {
+public:
+    // 0 threads: one per hardware thread.
+    explicit MothershipWorkPool(unsigned threads = 0);
+    ~MothershipWorkPool();
+
+    MothershipWorkPool(const MothershipWorkPool&) = delete;
+    MothershipWorkPool& operator=(const MothershipWorkPool&) = delete;
+
+    // Calls job(i) once for every i in [0, count) and returns when all
+    // calls have finished. Not reentrant; `job` must be safe to call
+    // concurrently for different indices.
+    void ParallelFor(size_t count, const std::function<void(size_t)>& job);
+
+    inline unsigned Threads() const {
+        return static_cast<unsigned>(workers.size()) + 1;
+    }
+
+private:
+    struct Range {
+        size_t begin;
+        size_t end;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+
+    void WorkerLoop(unsigned self);
+    void Drain(unsigned self);
+    bool Take(unsigned self, Range& range);
+    bool Steal(unsigned self, Range& range);
+    void Finished(size_t items);
+
+    std::vector<std::thread> workers;
+    // queues[0] belongs to the calling thread, queues[i] to workers[i - 1].
+    std::vector<std::unique_ptr<Queue>> queues;
+    const std::function<void(size_t)>* job = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    unsigned long long generation = 0;
+    std::atomic<size_t> remaining{0};
+    unsigned busy = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,25 @@
+#include "storage/data_directory.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <system_error>
+
+std::string MothershipDataDirectory() {
+    std::filesystem::path dir;
+    if (const char* env = std::getenv("MOTHERSHIP_DATA_DIR"); env && *env) {
+        dir = env;
+    } else if (const char* xdg = std::getenv("XDG_DATA_HOME"); xdg && *xdg) {
+        dir = std::filesystem::path(xdg) / "mothership";
+    } else if (const char* home = std::getenv("HOME"); home && *home) {
+        dir = std::filesystem::path(home) / ".local" / "share" / "mothership";
+    } else {
+        dir = ".mothership";
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    return dir.string();
+}
+
+std::string MothershipDataPath(const std::string& fileName) {
+    return (std::filesystem::path(MothershipDataDirectory()) / fileName).string();
+}
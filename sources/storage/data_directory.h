@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+// Directory holding Mothership's local data (snapshots, caches).
+// Resolved from $MOTHERSHIP_DATA_DIR, then $XDG_DATA_HOME/mothership,
+// then $HOME/.local/share/mothership. Created on first use.
+std::string MothershipDataDirectory();
+
+// Path of a file inside the data directory.
+std::string MothershipDataPath(const std::string& fileName);
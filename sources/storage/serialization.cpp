@@ -0,0 +1,176 @@
+#include "storage/serialization.h"
+
+#include <algorithm>
+
+namespace {
+
+typedef std::chrono::time_point<std::chrono::system_clock> TimePoint;
+
+long long ToMicros(const TimePoint& time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+TimePoint FromMicros(long long micros) {
+    return TimePoint(std::chrono::duration_cast<TimePoint::duration>(std::chrono::microseconds(micros)));
+}
+
+nlohmann::json StampToJson(const MothershipStamp& stamp) {
+    return {{"clock", stamp.clock}, {"device", stamp.device}};
+}
+
+MothershipStamp StampFromJson(const nlohmann::json& j) {
+    MothershipStamp stamp;
+    stamp.clock = j.value("clock", uint64_t(0));
+    stamp.device = j.value("device", std::string());
+    return stamp;
+}
+
+nlohmann::json ColorToJson(const MothershipColor& color) {
+    if (color.isCustomColor) {
+        return {{"r", color.r}, {"g", color.g}, {"b", color.b}};
+    }
+    return {{"code", color.colorCode}};
+}
+
+MothershipColor ColorFromJson(const nlohmann::json& j) {
+    if (j.is_object() && j.contains("r")) {
+        return MothershipColor(j.value("r", (unsigned short)0), j.value("g", (unsigned short)0),
+                               j.value("b", (unsigned short)0));
+    }
+    return MothershipColor(j.is_object() ? j.value("code", -1) : -1);
+}
+
+} // namespace
+
+nlohmann::json TimeframeToJson(const SingleTimeframe& timeframe) {
+    nlohmann::json j = {
+        {"id", timeframe.id},
+        {"device", timeframe.originDevice},
+        {"clock", timeframe.clock},
+        {"started", timeframe.started},
+        {"finished", timeframe.finished}
+    };
+    if (timeframe.started || timeframe.finished) {
+        j["start_us"] = ToMicros(timeframe.startTime);
+    }
+    if (timeframe.finished) {
+        j["end_us"] = ToMicros(timeframe.endTime);
+    }
+    return j;
+}
+
+bool TimeframeFromJson(const nlohmann::json& j, SingleTimeframe& timeframe) {
+    if (!j.is_object() || !j.contains("id")) {
+        return false;
+    }
+    timeframe.id = j.value("id", std::string());
+    timeframe.originDevice = j.value("device", std::string());
+    timeframe.clock = j.value("clock", uint64_t(0));
+    timeframe.started = j.value("started", false);
+    timeframe.finished = j.value("finished", false);
+    timeframe.startTime = FromMicros(j.value("start_us", 0LL));
+    timeframe.endTime = FromMicros(j.value("end_us", 0LL));
+    return true;
+}
+
+nlohmann::json TaskToJson(const MothershipTask& task, bool withSketches) {
+    nlohmann::json frames = nlohmann::json::array();
+    for (auto& [index, timeframe] : task.timeFrames) {
+        frames.push_back(TimeframeToJson(timeframe));
+    }
+    nlohmann::json j = {
+        {"title", task.title},
+        {"color", ColorToJson(task.color)},
+        {"stamp", StampToJson(task.stamp)},
+        {"current", task.currentTimeframe},
+        {"timeframes", std::move(frames)}
+    };
+    if (withSketches) {
+        if (const MothershipDurationHistogram* built = task.BuiltSessionLengths()) {
+            j["session_lengths"] = built->ToJson();
+        } else {
+            MothershipDurationHistogram lengths;
+            for (auto& [index, timeframe] : task.timeFrames) {
+                if (timeframe.finished) {
+                    lengths.Record(std::chrono::floor<MothershipDuration>(timeframe.endTime - timeframe.startTime));
+                }
+            }
+            j["session_lengths"] = lengths.ToJson();
+        }
+    }
+    return j;
+}
+
+bool TaskFromJson(const nlohmann::json& j, MothershipTask& task) {
+    if (!j.is_object() || !j.contains("title")) {
+        return false;
+    }
+    task.title = j.value("title", std::string());
+    task.color = ColorFromJson(j.value("color", nlohmann::json()));
+    task.stamp = StampFromJson(j.value("stamp", nlohmann::json::object()));
+    task.timeFrames.clear();
+    int index = 0;
+    uint64_t finished = 0;
+    for (auto& item : j.value("timeframes", nlohmann::json::array())) {
+        SingleTimeframe timeframe;
+        if (!TimeframeFromJson(item, timeframe)) {
+            return false;
+        }
+        finished += timeframe.finished ? 1 : 0;
+        task.timeFrames.emplace_hint(task.timeFrames.end(), index++, std::move(timeframe));
+    }
+    task.currentTimeframe = j.value("current", task.timeFrames.empty() ? -1 : index - 1);
+    task.CalculateTotalTime();
+    task.InvalidateAggregates();
+    // Older snapshots have no histogram; one that disagrees is rebuilt on use.
+    MothershipDurationHistogram lengths;
+    if (j.contains("session_lengths") && lengths.FromJson(j["session_lengths"]) && lengths.Count() == finished) {
+        task.AdoptSessionLengths(std::move(lengths));
+    }
+    return true;
+}
+
+nlohmann::json DataToJson(const MothershipData& data, bool withSketches) {
+    nlohmann::json tasks = nlohmann::json::array();
+    for (auto& [title, task] : data.tasks) {
+        tasks.push_back(TaskToJson(task, withSketches));
+    }
+    nlohmann::json tombstones = nlohmann::json::object();
+    for (auto& [title, stamp] : data.tombstones) {
+        tombstones[title] = StampToJson(stamp);
+    }
+    return {{"tasks", std::move(tasks)}, {"tombstones", std::move(tombstones)}};
+}
+
+bool DataFromJson(const nlohmann::json& j, MothershipData& data) {
+    if (!j.is_object()) {
+        return false;
+    }
+    // Keep the local logical clock ahead of everything that was loaded.
+    uint64_t maxClock = 0;
+    MothershipData::_Tasks tasks;
+    for (auto& item : j.value("tasks", nlohmann::json::array())) {
+        MothershipTask task("", MothershipColor(-1));
+        if (!TaskFromJson(item, task)) {
+            return false;
+        }
+        maxClock = std::max(maxClock, task.stamp.clock);
+        for (auto& [index, timeframe] : task.timeFrames) {
+            maxClock = std::max(maxClock, timeframe.clock);
+        }
+        std::string title = task.title;
+        tasks.emplace(std::move(title), std::move(task));
+    }
+    MothershipData::_Tombstones tombstones;
+    nlohmann::json erased = j.value("tombstones", nlohmann::json::object());
+    for (auto& [title, stamp] : erased.items()) {
+        MothershipStamp tombstone = StampFromJson(stamp);
+        maxClock = std::max(maxClock, tombstone.clock);
+        tombstones.emplace(title, std::move(tombstone));
+    }
+    MothershipClockObserve(maxClock);
+    data.tasks = std::move(tasks);
+    data.tombstones = std::move(tombstones);
+    data.InvalidateIndex();
+    return true;
+}
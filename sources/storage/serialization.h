@@ -0,0 +1,19 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include "mothership_data.h"
+
+// JSON form of the data model, used for snapshots and for exchanging
+// histories between replicas. Time points are stored as unix microseconds.
+// Snapshots also carry each task's session-length histogram (`withSketches`);
+// replicas rebuild theirs from the timeframes.
+
+nlohmann::json TimeframeToJson(const SingleTimeframe& timeframe);
+bool TimeframeFromJson(const nlohmann::json& j, SingleTimeframe& timeframe);
+
+nlohmann::json TaskToJson(const MothershipTask& task, bool withSketches = false);
+bool TaskFromJson(const nlohmann::json& j, MothershipTask& task);
+
+nlohmann::json DataToJson(const MothershipData& data, bool withSketches = false);
+bool DataFromJson(const nlohmann::json& j, MothershipData& data);
@@ -0,0 +1,47 @@
+#include "storage/snapshot.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "storage/data_directory.h"
+#include "storage/serialization.h"
+
+std::string MothershipSnapshotPath() {
+    return MothershipDataPath("snapshot.json");
+}
+
+bool LoadSnapshot(MothershipData& data, const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    nlohmann::json doc = nlohmann::json::parse(in, nullptr, false);
+    if (doc.is_discarded()) {
+        return false;
+    }
+    return DataFromJson(doc, data);
+}
+
+std::string EncodeSnapshot(const MothershipData& data) {
+    return DataToJson(data, true).dump();
+}
+
+bool WriteSnapshot(const std::string& encoded, const std::string& path) {
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out << encoded;
+        out.flush();
+        if (!out) {
+            return false;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
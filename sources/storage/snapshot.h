@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+
+#include "mothership_data.h"
+
+// Local persistence of the whole data model as one JSON document.
+
+std::string MothershipSnapshotPath();
+
+bool LoadSnapshot(MothershipData& data, const std::string& path);
+// Serialized form, so the (cheap) encoding can happen on the owning thread
+// and the write elsewhere.
+std::string EncodeSnapshot(const MothershipData& data);
+// Writes atomically through a temporary file and rename.
+bool WriteSnapshot(const std::string& encoded, const std::string& path);
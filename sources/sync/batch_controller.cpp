@@ -0,0 +1,56 @@
+#include "sync/batch_controller.h"
+
+#include <algorithm>
+
+#include "metrics.h"
+
+MothershipBatchController::MothershipBatchController(const MothershipBatchControllerConfig& config)
+    : config(config),
+      batchSize(std::clamp(config.initialBatch, config.minBatch, config.maxBatch)),
+      concurrency(std::clamp(config.initialConcurrency, config.minConcurrency, config.maxConcurrency)) {
+    Publish(0.0);
+}
+
+MothershipBatchController::Decision MothershipBatchController::OnRound(size_t eventsDelivered, double seconds,
+                                                                       size_t failures, bool rateLimited) {
+    double throughput = seconds > 0.0 ? eventsDelivered / seconds : 0.0;
+
+    if (failures > 0 || rateLimited) {
+        batchSize = std::max(config.minBatch, static_cast<size_t>(batchSize * config.decreaseFactor));
+        concurrency = std::max(config.minConcurrency, static_cast<int>(concurrency * config.decreaseFactor));
+        bestThroughput = 0.0;
+        increaseStreak = 0;
+        lastDecision = Decrease;
+    } else if (throughput >= bestThroughput * config.throughputTolerance) {
+        bestThroughput = std::max(bestThroughput, throughput);
+        batchSize = std::min(config.maxBatch, batchSize + config.batchStep);
+        increaseStreak += 1;
+        if (increaseStreak >= config.concurrencyProbeRounds) {
+            concurrency = std::min(config.maxConcurrency, concurrency + 1);
+            increaseStreak = 0;
+        }
+        lastDecision = Increase;
+    } else {
+        // Larger batches stopped paying off: step back from the last increase.
+        batchSize = std::max(config.minBatch, batchSize > config.batchStep ? batchSize - config.batchStep : config.minBatch);
+        increaseStreak = 0;
+        lastDecision = Backoff;
+    }
+    bestThroughput *= config.bestDecay;
+
+    Publish(throughput);
+    return lastDecision;
+}
+
+void MothershipBatchController::Publish(double throughput) {
+    MothershipMetrics& metrics = MothershipMetrics::Instance();
+    metrics.SetGauge("sync.batch_size", static_cast<double>(batchSize));
+    metrics.SetGauge("sync.concurrency", concurrency);
+    metrics.SetGauge("sync.throughput_events_per_s", throughput);
+    switch (lastDecision) {
+        case Increase: metrics.Increment("sync.aimd_increase"); break;
+        case Backoff: metrics.Increment("sync.aimd_backoff"); break;
+        case Decrease: metrics.Increment("sync.aimd_decrease"); break;
+        case Hold: break;
+    }
+}
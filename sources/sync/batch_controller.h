@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+
+struct MothershipBatchControllerConfig {
+    size_t minBatch = 10;
+    size_t maxBatch = 5000;
+    size_t initialBatch = 100;
+    size_t batchStep = 50;
+
+    int minConcurrency = 1;
+    int maxConcurrency = 8;
+    int initialConcurrency = 1;
+    // Consecutive increases before another parallel request is tried.
+    int concurrencyProbeRounds = 4;
+
+    // Multiplicative decrease applied to both knobs on errors.
+    double decreaseFactor = 0.5;
+    // A round counts as an improvement above this fraction of the best seen.
+    double throughputTolerance = 0.9;
+    // Per-round decay of the best throughput, so the link is re-probed.
+    double bestDecay = 0.98;
+};
+
+// AIMD controller for upload batch size and concurrency. Sizes grow
+// additively while throughput keeps up and collapse multiplicatively on
+// errors or rate limiting. Every decision is published to MothershipMetrics
+// under "sync.*".
+class MothershipBatchController {
+public:
+    enum Decision {
+        Hold,
+        Increase,
+        Backoff,
+        Decrease
+    };
+
+    explicit MothershipBatchController(const MothershipBatchControllerConfig& config = MothershipBatchControllerConfig());
+
+    // Feeds the outcome of one round of concurrent batches.
+    Decision OnRound(size_t eventsDelivered, double seconds, size_t failures, bool rateLimited);
+
+    inline size_t BatchSize() const {
+        return batchSize;
+    }
+    inline int Concurrency() const {
+        return concurrency;
+    }
+    inline double BestThroughput() const {
+        return bestThroughput;
+    }
+    inline Decision LastDecision() const {
+        return lastDecision;
+    }
+    inline const MothershipBatchControllerConfig& Config() const {
+        return config;
+    }
+
+private:
+    void Publish(double throughput);
+
+    MothershipBatchControllerConfig config;
+    size_t batchSize;
+    int concurrency;
+    int increaseStreak = 0;
+    double bestThroughput = 0.0;
+    Decision lastDecision = Hold;
+};
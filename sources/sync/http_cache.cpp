@@ -0,0 +1,97 @@
+#include "sync/http_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+MothershipHttpCache::MothershipHttpCache(const std::string& path) : path(path) {
+
+}
+
+bool MothershipHttpCache::Load() {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    nlohmann::json doc = nlohmann::json::parse(in, nullptr, false);
+    if (doc.is_discarded() || !doc.is_object()) {
+        return false;
+    }
+    entries.clear();
+    for (auto& [url, item] : doc.items()) {
+        if (!item.is_object()) {
+            continue;
+        }
+        MothershipCachedResponse entry;
+        entry.etag = item.value("etag", "");
+        entry.lastModified = item.value("lastModified", "");
+        entry.contentType = item.value("contentType", "");
+        entry.body = item.value("body", "");
+        entry.storedAt = item.value("storedAt", 0LL);
+        if (entry.etag.empty() && entry.lastModified.empty()) {
+            continue;
+        }
+        entries.emplace(url, std::move(entry));
+    }
+    dirty = false;
+    return true;
+}
+
+bool MothershipHttpCache::Save() {
+    nlohmann::json doc = nlohmann::json::object();
+    for (auto& [url, entry] : entries) {
+        doc[url] = {
+            {"etag", entry.etag},
+            {"lastModified", entry.lastModified},
+            {"contentType", entry.contentType},
+            {"body", entry.body},
+            {"storedAt", entry.storedAt}
+        };
+    }
+    // Write to a sibling file and rename so a crash never leaves a torn cache.
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out << doc.dump();
+        if (!out) {
+            return false;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    dirty = false;
+    return true;
+}
+
+const MothershipCachedResponse* MothershipHttpCache::Find(const std::string& url) const {
+    auto it = entries.find(url);
+    if (it != entries.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+void MothershipHttpCache::Store(const std::string& url, const MothershipCachedResponse& response) {
+    entries[url] = response;
+    dirty = true;
+}
+
+bool MothershipHttpCache::Erase(const std::string& url) {
+    if (entries.erase(url) > 0) {
+        dirty = true;
+        return true;
+    }
+    return false;
+}
+
+void MothershipHttpCache::Clear() {
+    if (!entries.empty()) {
+        entries.clear();
+        dirty = true;
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+// Validators and payload of a previously fetched GET response.
+struct MothershipCachedResponse {
+    std::string etag;
+    std::string lastModified;
+    std::string contentType;
+    std::string body;
+    long long storedAt = 0; // unix seconds
+};
+
+// Response cache keyed by URL, used to issue conditional GETs
+// (If-None-Match / If-Modified-Since) and serve the body on 304.
+// Persisted as JSON next to the rest of the local data.
+class MothershipHttpCache {
+public:
+    typedef std::unordered_map<std::string, MothershipCachedResponse> _Entries;
+
+    explicit MothershipHttpCache(const std::string& path);
+
+    bool Load();
+    bool Save();
+
+    const MothershipCachedResponse* Find(const std::string& url) const;
+    void Store(const std::string& url, const MothershipCachedResponse& response);
+    bool Erase(const std::string& url);
+    void Clear();
+
+    inline bool Dirty() const {
+        return dirty;
+    }
+    inline size_t Size() const {
+        return entries.size();
+    }
+    inline const std::string& Path() const {
+        return path;
+    }
+
+private:
+    std::string path;
+    _Entries entries;
+    bool dirty = false;
+};
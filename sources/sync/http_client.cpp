@@ -0,0 +1,231 @@
+#include "sync/http_client.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <curl/curl.h>
+#include <mutex>
+
+namespace {
+
+std::once_flag curlGlobalInit;
+
+std::string Trim(const std::string& s) {
+    size_t begin = 0;
+    size_t end = s.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(s[begin]))) {
+        ++begin;
+    }
+    while (end > begin && std::isspace(static_cast<unsigned char>(s[end - 1]))) {
+        --end;
+    }
+    return s.substr(begin, end - begin);
+}
+
+double TotalMs(CURL* handle) {
+    double seconds = 0.0;
+    curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME, &seconds);
+    return seconds * 1000.0;
+}
+
+size_t WriteBody(char* data, size_t size, size_t count, void* user) {
+    std::string* body = static_cast<std::string*>(user);
+    body->append(data, size * count);
+    return size * count;
+}
+
+size_t WriteHeader(char* data, size_t size, size_t count, void* user) {
+    auto* headers = static_cast<std::map<std::string, std::string>*>(user);
+    std::string line(data, size * count);
+    // A new status line starts a fresh header block (redirects, 100-continue).
+    if (line.rfind("HTTP/", 0) == 0) {
+        headers->clear();
+        return size * count;
+    }
+    size_t colon = line.find(':');
+    if (colon != std::string::npos) {
+        std::string name = Trim(line.substr(0, colon));
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        (*headers)[name] = Trim(line.substr(colon + 1));
+    }
+    return size * count;
+}
+
+} // namespace
+
+std::string MothershipHttpResponse::Header(const std::string& name) const {
+    auto it = headers.find(name);
+    if (it != headers.end()) {
+        return it->second;
+    }
+    return std::string();
+}
+
+MothershipHttpClient::MothershipHttpClient(MothershipHttpCache* cache) : cache(cache) {
+    std::call_once(curlGlobalInit, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+    curl = curl_easy_init();
+}
+
+MothershipHttpClient::~MothershipHttpClient() {
+    for (CURL* handle : pool) {
+        curl_easy_cleanup(handle);
+    }
+    if (multi) {
+        curl_multi_cleanup(multi);
+    }
+    if (curl) {
+        curl_easy_cleanup(curl);
+    }
+}
+
+bool MothershipHttpClient::Get(const std::string& url, MothershipHttpResponse& response) {
+    std::map<std::string, std::string> requestHeaders;
+    const MothershipCachedResponse* cached = cache ? cache->Find(url) : nullptr;
+    if (cached) {
+        if (!cached->etag.empty()) {
+            requestHeaders["If-None-Match"] = cached->etag;
+        }
+        if (!cached->lastModified.empty()) {
+            requestHeaders["If-Modified-Since"] = cached->lastModified;
+        }
+    }
+
+    if (!Perform(url, nullptr, requestHeaders, response)) {
+        return false;
+    }
+
+    if (response.status == 304 && cached) {
+        response.body = cached->body;
+        response.fromCache = true;
+        return true;
+    }
+    if (cache && response.status == 200) {
+        std::string etag = response.Header("etag");
+        std::string lastModified = response.Header("last-modified");
+        if (!etag.empty() || !lastModified.empty()) {
+            MothershipCachedResponse entry;
+            entry.etag = etag;
+            entry.lastModified = lastModified;
+            entry.contentType = response.Header("content-type");
+            entry.body = response.body;
+            entry.storedAt = std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            cache->Store(url, entry);
+        } else {
+            cache->Erase(url);
+        }
+    }
+    return true;
+}
+
+bool MothershipHttpClient::Post(const std::string& url, const std::string& body,
+                                const std::string& contentType, MothershipHttpResponse& response) {
+    std::map<std::string, std::string> requestHeaders;
+    requestHeaders["Content-Type"] = contentType;
+    return Perform(url, &body, requestHeaders, response);
+}
+
+bool MothershipHttpClient::PostMany(const std::string& url, const std::vector<std::string>& bodies,
+                                    const std::string& contentType, std::vector<MothershipHttpResponse>& responses) {
+    responses.assign(bodies.size(), MothershipHttpResponse());
+    if (bodies.empty()) {
+        return true;
+    }
+    if (!multi) {
+        multi = curl_multi_init();
+    }
+    while (pool.size() < bodies.size()) {
+        pool.push_back(curl_easy_init());
+    }
+
+    std::map<std::string, std::string> requestHeaders;
+    requestHeaders["Content-Type"] = contentType;
+    std::vector<curl_slist*> headerLists(bodies.size(), nullptr);
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        headerLists[i] = Prepare(pool[i], url, &bodies[i], requestHeaders, responses[i]);
+        curl_easy_setopt(pool[i], CURLOPT_PRIVATE, reinterpret_cast<void*>(i));
+        curl_multi_add_handle(multi, pool[i]);
+    }
+
+    int running = 0;
+    do {
+        curl_multi_perform(multi, &running);
+        if (running > 0) {
+            curl_multi_poll(multi, nullptr, 0, 100, nullptr);
+        }
+    } while (running > 0);
+
+    bool allOk = true;
+    int queued = 0;
+    while (CURLMsg* message = curl_multi_info_read(multi, &queued)) {
+        if (message->msg != CURLMSG_DONE) {
+            continue;
+        }
+        void* index = nullptr;
+        curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &index);
+        MothershipHttpResponse& response = responses[reinterpret_cast<size_t>(index)];
+        if (message->data.result != CURLE_OK) {
+            response.error = curl_easy_strerror(message->data.result);
+            allOk = false;
+        } else {
+            curl_easy_getinfo(message->easy_handle, CURLINFO_RESPONSE_CODE, &response.status);
+            response.totalMs = TotalMs(message->easy_handle);
+        }
+    }
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        curl_multi_remove_handle(multi, pool[i]);
+        curl_slist_free_all(headerLists[i]);
+    }
+    return allOk;
+}
+
+curl_slist* MothershipHttpClient::Prepare(CURL* handle, const std::string& url, const std::string* postBody,
+                                         const std::map<std::string, std::string>& requestHeaders,
+                                         MothershipHttpResponse& response) {
+    curl_slist* headerList = nullptr;
+    for (auto& [name, value] : requestHeaders) {
+        std::string line = name + ": " + value;
+        headerList = curl_slist_append(headerList, line.c_str());
+    }
+    // Disable the implicit "Expect: 100-continue" round trip on uploads.
+    headerList = curl_slist_append(headerList, "Expect:");
+
+    curl_easy_reset(handle);
+    curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headerList);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, WriteBody);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &response.body);
+    curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, WriteHeader);
+    curl_easy_setopt(handle, CURLOPT_HEADERDATA, &response.headers);
+    curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, timeoutMs);
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");
+    if (postBody) {
+        curl_easy_setopt(handle, CURLOPT_POST, 1L);
+        curl_easy_setopt(handle, CURLOPT_POSTFIELDS, postBody->data());
+        curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(postBody->size()));
+    }
+    return headerList;
+}
+
+bool MothershipHttpClient::Perform(const std::string& url, const std::string* postBody,
+                                   const std::map<std::string, std::string>& requestHeaders,
+                                   MothershipHttpResponse& response) {
+    response = MothershipHttpResponse();
+    if (!curl) {
+        response.error = "curl_easy_init failed";
+        return false;
+    }
+
+    curl_slist* headerList = Prepare(curl, url, postBody, requestHeaders, response);
+    CURLcode code = curl_easy_perform(curl);
+    curl_slist_free_all(headerList);
+    if (code != CURLE_OK) {
+        response.error = curl_easy_strerror(code);
+        return false;
+    }
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.status);
+    response.totalMs = TotalMs(curl);
+    return true;
+}
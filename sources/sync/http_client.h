@@ -0,0 +1,69 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sync/http_cache.h"
+
+typedef void CURL;
+typedef void CURLM;
+struct curl_slist;
+
+struct MothershipHttpResponse {
+    long status = 0;
+    std::string body;
+    // Header names are lower-cased; the last occurrence wins.
+    std::map<std::string, std::string> headers;
+    // True when the body was served from the local cache after a 304.
+    bool fromCache = false;
+    std::string error;
+    // Time this request took, from curl; its own even when sent with others.
+    double totalMs = 0.0;
+
+    inline bool Ok() const {
+        return status >= 200 && status < 300;
+    }
+    std::string Header(const std::string& name) const;
+};
+
+// Thin libcurl wrapper. Easy handles are owned by the client so connections
+// are kept alive across requests. When a cache is attached, GETs are made
+// conditional on the stored validators.
+class MothershipHttpClient {
+public:
+    explicit MothershipHttpClient(MothershipHttpCache* cache = nullptr);
+    ~MothershipHttpClient();
+
+    MothershipHttpClient(const MothershipHttpClient&) = delete;
+    MothershipHttpClient& operator=(const MothershipHttpClient&) = delete;
+
+    bool Get(const std::string& url, MothershipHttpResponse& response);
+    bool Post(const std::string& url, const std::string& body,
+              const std::string& contentType, MothershipHttpResponse& response);
+    // Posts every body to `url` concurrently; responses[i] answers bodies[i].
+    // Returns false if any transfer failed at the transport level.
+    bool PostMany(const std::string& url, const std::vector<std::string>& bodies,
+                  const std::string& contentType, std::vector<MothershipHttpResponse>& responses);
+
+    inline void SetTimeoutMs(long timeoutMs) {
+        this->timeoutMs = timeoutMs;
+    }
+    inline MothershipHttpCache* Cache() {
+        return cache;
+    }
+
+private:
+    bool Perform(const std::string& url, const std::string* postBody,
+                 const std::map<std::string, std::string>& requestHeaders,
+                 MothershipHttpResponse& response);
+    curl_slist* Prepare(CURL* handle, const std::string& url, const std::string* postBody,
+                        const std::map<std::string, std::string>& requestHeaders,
+                        MothershipHttpResponse& response);
+
+    CURL* curl = nullptr;
+    CURLM* multi = nullptr;
+    std::vector<CURL*> pool;
+    MothershipHttpCache* cache = nullptr;
+    long timeoutMs = 10000;
+};
@@ -0,0 +1,222 @@
+#include "sync/merkle_history.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <set>
+
+namespace {
+
+inline uint64_t Mix(uint64_t x) {
+    // splitmix64 finalizer
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+inline uint64_t HashBytes(const std::string& s, uint64_t seed = 0xcbf29ce484222325ULL) {
+    uint64_t h = seed;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return Mix(h);
+}
+
+inline uint64_t HashCombine(uint64_t h, uint64_t v) {
+    return Mix(h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2)));
+}
+
+long long Micros(const std::chrono::system_clock::time_point& time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+uint64_t TimeframeHash(const SingleTimeframe& timeframe) {
+    uint64_t h = HashBytes(timeframe.id);
+    h = HashCombine(h, static_cast<uint64_t>(timeframe.StateRank()));
+    h = HashCombine(h, timeframe.clock);
+    h = HashCombine(h, static_cast<uint64_t>(Micros(timeframe.startTime)));
+    if (timeframe.finished) {
+        h = HashCombine(h, static_cast<uint64_t>(Micros(timeframe.endTime)));
+    }
+    return h;
+}
+
+uint64_t StampHash(const MothershipStamp& stamp) {
+    return HashCombine(HashBytes(stamp.device), stamp.clock);
+}
+
+uint64_t ColorHash(const MothershipColor& color) {
+    if (color.isCustomColor) {
+        return HashCombine(HashCombine(HashCombine(1, color.r), color.g), color.b);
+    }
+    return HashCombine(0, static_cast<uint64_t>(color.colorCode));
+}
+
+// Contribution of a child to its parent's hash.
+inline uint64_t ChildTerm(const std::string& key, uint64_t hash) {
+    return Mix(HashBytes(key) + hash * 0x9e3779b97f4a7c15ULL);
+}
+
+// Parent of a leaf ("day/title") is its day; of a day or month, the key up to
+// its last '-'. Cut at separators so years of any width or sign roll up right.
+inline std::string ParentKey(const std::string& key) {
+    size_t slash = key.find('/');
+    return slash != std::string::npos ? key.substr(0, slash) : key.substr(0, key.rfind('-'));
+}
+
+} // namespace
+
+const char* MothershipMerkleTree::MetaKey = "~meta";
+
+std::string MothershipMerkleTree::DayKey(const std::chrono::system_clock::time_point& time) {
+    std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    // Room for any int year; Build splits keys at the separators, not fixed widths.
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", utc.tm_year + 1900, utc.tm_mon + 1, utc.tm_mday);
+    return buffer;
+}
+
+bool MothershipMerkleTree::IsLeaf(const std::string& key) {
+    return key == MetaKey || key.find('/') != std::string::npos;
+}
+
+void MothershipMerkleTree::Build(const MothershipData& data) {
+    nodes.clear();
+    std::unordered_map<std::string, uint64_t> leaves;
+
+    uint64_t meta = 0;
+    for (auto& [title, task] : data.tasks) {
+        meta += Mix(HashCombine(HashBytes(title), HashCombine(StampHash(task.stamp), ColorHash(task.color))));
+        // Consecutive timeframes usually share a day; reuse the last key.
+        std::chrono::system_clock::time_point lastDay;
+        std::string day;
+        for (auto& [index, timeframe] : task.timeFrames) {
+            auto dayStart = std::chrono::floor<std::chrono::days>(timeframe.startTime);
+            if (day.empty() || dayStart != lastDay) {
+                lastDay = dayStart;
+                day = DayKey(timeframe.startTime);
+            }
+            leaves[day + "/" + title] += TimeframeHash(timeframe);
+        }
+    }
+    for (auto& [title, stamp] : data.tombstones) {
+        meta += Mix(HashCombine(HashBytes(title, 0x84222325cbf29ce4ULL), StampHash(stamp)));
+    }
+
+    Node& root = nodes[""];
+    if (!data.tasks.empty() || !data.tombstones.empty()) {
+        nodes[MetaKey].hash = meta;
+        root.children[MetaKey] = meta;
+    }
+
+    // Roll leaves up into day, month and year nodes.
+    for (auto& [key, hash] : leaves) {
+        nodes[key].hash = hash;
+        nodes[ParentKey(key)].children[key] = hash;
+    }
+    std::set<std::string> days;
+    for (auto& [key, hash] : leaves) {
+        days.insert(ParentKey(key));
+    }
+    for (const std::string& day : days) {
+        Node& node = nodes[day];
+        for (auto& [child, hash] : node.children) {
+            node.hash += ChildTerm(child, hash);
+        }
+        nodes[ParentKey(day)].children[day] = node.hash;
+    }
+    std::set<std::string> months;
+    for (const std::string& day : days) {
+        months.insert(ParentKey(day));
+    }
+    for (const std::string& month : months) {
+        Node& node = nodes[month];
+        for (auto& [child, hash] : node.children) {
+            node.hash += ChildTerm(child, hash);
+        }
+        nodes[ParentKey(month)].children[month] = node.hash;
+    }
+    std::set<std::string> years;
+    for (const std::string& month : months) {
+        years.insert(ParentKey(month));
+    }
+    for (const std::string& year : years) {
+        Node& node = nodes[year];
+        for (auto& [child, hash] : node.children) {
+            node.hash += ChildTerm(child, hash);
+        }
+        root.children[year] = node.hash;
+    }
+    for (auto& [child, hash] : root.children) {
+        root.hash += ChildTerm(child, hash);
+    }
+}
+
+uint64_t MothershipMerkleTree::Hash(const std::string& key) const {
+    auto it = nodes.find(key);
+    return it != nodes.end() ? it->second.hash : 0;
+}
+
+const MothershipMerkleTree::_Children* MothershipMerkleTree::Children(const std::string& key) const {
+    if (IsLeaf(key)) {
+        return nullptr;
+    }
+    auto it = nodes.find(key);
+    return it != nodes.end() ? &it->second.children : nullptr;
+}
+
+MothershipData ExtractLeaves(const MothershipData& data, const std::vector<std::string>& leafKeys) {
+    MothershipData partial;
+    bool withMeta = false;
+    // title -> days wanted
+    std::map<std::string, std::set<std::string>> wanted;
+    for (const std::string& key : leafKeys) {
+        if (key == MothershipMerkleTree::MetaKey) {
+            withMeta = true;
+            continue;
+        }
+        size_t slash = key.find('/');
+        if (slash != std::string::npos) {
+            wanted[key.substr(slash + 1)].insert(key.substr(0, slash));
+        }
+    }
+
+    for (auto& [title, task] : data.tasks) {
+        auto want = wanted.find(title);
+        if (!withMeta && want == wanted.end()) {
+            continue;
+        }
+        MothershipTask copy(task.title, task.color);
+        copy.stamp = task.stamp;
+        if (want != wanted.end()) {
+            int index = 0;
+            for (auto& [oldIndex, timeframe] : task.timeFrames) {
+                if (want->second.count(MothershipMerkleTree::DayKey(timeframe.startTime))) {
+                    copy.timeFrames.emplace_hint(copy.timeFrames.end(), index++, timeframe);
+                }
+            }
+            copy.currentTimeframe = index - 1;
+        }
+        partial.tasks.emplace_hint(partial.tasks.end(), title, std::move(copy));
+    }
+    if (withMeta) {
+        partial.tombstones = data.tombstones;
+    }
+    return partial;
+}
+
+std::string MerkleHashToHex(uint64_t hash) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+uint64_t MerkleHashFromHex(const std::string& hex) {
+    return std::strtoull(hex.c_str(), nullptr, 16);
+}
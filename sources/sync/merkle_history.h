@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mothership_data.h"
+
+// Hash tree over a history, used to find where two replicas diverge
+// without transferring the history itself.
+//
+//   ""                       root
+//   "2026"                   year
+//   "2026-10"                month
+//   "2026-10-19"             day (UTC, by timeframe start)
+//   "2026-10-19/<title>"     leaf: one task's timeframes on that day
+//   "~meta"                  leaf: task colors/stamps and tombstones
+//
+// Hashes are order independent sums of mixed element hashes, so a
+// replica can build the same tree from any iteration order.
+class MothershipMerkleTree {
+public:
+    typedef std::map<std::string, uint64_t> _Children;
+
+    static const char* MetaKey;
+
+    void Build(const MothershipData& data);
+
+    // 0 when the node does not exist.
+    uint64_t Hash(const std::string& key) const;
+    // Null when the node does not exist or is a leaf.
+    const _Children* Children(const std::string& key) const;
+
+    static bool IsLeaf(const std::string& key);
+    static std::string DayKey(const std::chrono::system_clock::time_point& time);
+
+    inline size_t NodeCount() const {
+        return nodes.size();
+    }
+
+private:
+    struct Node {
+        uint64_t hash = 0;
+        _Children children;
+    };
+
+    std::unordered_map<std::string, Node> nodes;
+};
+
+// The part of `data` covered by the given leaf keys: the tasks' timeframes
+// on those days and, for "~meta", every task's color/stamp and the
+// tombstones. Suitable for MergeReplica.
+MothershipData ExtractLeaves(const MothershipData& data, const std::vector<std::string>& leafKeys);
+
+std::string MerkleHashToHex(uint64_t hash);
+uint64_t MerkleHashFromHex(const std::string& hex);
@@ -0,0 +1,111 @@
+#include "sync/rate_limiter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <ctime>
+#include <curl/curl.h>
+#include <thread>
+
+bool ParseRetryAfter(const std::string& headerValue, double& seconds) {
+    if (headerValue.empty()) {
+        return false;
+    }
+    // The server picks the value: clamp it before it becomes a duration.
+    const double longest = MothershipRateLimiter::maxRetryAfterSeconds;
+    if (std::all_of(headerValue.begin(), headerValue.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        uint64_t delta = 0;
+        const char* end = headerValue.data() + headerValue.size();
+        auto [ptr, error] = std::from_chars(headerValue.data(), end, delta);
+        if (error != std::errc() || ptr != end) {
+            return false;
+        }
+        seconds = std::min(static_cast<double>(delta), longest);
+        return true;
+    }
+    time_t when = curl_getdate(headerValue.c_str(), nullptr);
+    if (when < 0) {
+        return false;
+    }
+    seconds = std::clamp(std::difftime(when, std::time(nullptr)), 0.0, longest);
+    return true;
+}
+
+MothershipRateLimiter::MothershipRateLimiter(double ratePerSecond, double burst)
+    : rate(ratePerSecond), burst(std::max(1.0, burst)), tokens(std::max(1.0, burst)),
+      lastRefill(Clock::now()), pausedUntil(Clock::time_point::min()) {
+
+}
+
+void MothershipRateLimiter::SetRate(double ratePerSecond, double burst) {
+    Refill(Clock::now());
+    rate = ratePerSecond;
+    this->burst = std::max(1.0, burst);
+    tokens = std::min(tokens, this->burst);
+}
+
+void MothershipRateLimiter::Refill(Clock::time_point now) {
+    if (now <= lastRefill) {
+        return;
+    }
+    if (rate > 0.0) {
+        double elapsed = std::chrono::duration<double>(now - lastRefill).count();
+        tokens = std::min(burst, tokens + elapsed * rate);
+    } else {
+        tokens = burst;
+    }
+    lastRefill = now;
+}
+
+MothershipRateLimiter::Clock::duration MothershipRateLimiter::WaitTime(double wanted, Clock::time_point now) {
+    Refill(now);
+    Clock::duration wait = Clock::duration::zero();
+    if (pausedUntil > now) {
+        wait = pausedUntil - now;
+    }
+    if (rate > 0.0 && tokens < wanted) {
+        // A request larger than the burst can never fill up; cap it at the burst.
+        double missing = std::min(wanted, burst) - tokens;
+        auto refill = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(missing / rate));
+        wait = std::max(wait, refill);
+    }
+    return wait;
+}
+
+bool MothershipRateLimiter::TryAcquire(double wanted, Clock::time_point now) {
+    if (WaitTime(wanted, now) > Clock::duration::zero()) {
+        return false;
+    }
+    if (rate > 0.0) {
+        tokens -= std::min(wanted, burst);
+    }
+    return true;
+}
+
+MothershipRateLimiter::Clock::duration MothershipRateLimiter::Acquire(double wanted) {
+    Clock::duration slept = Clock::duration::zero();
+    for (;;) {
+        Clock::time_point now = Clock::now();
+        Clock::duration wait = WaitTime(wanted, now);
+        if (wait <= Clock::duration::zero()) {
+            TryAcquire(wanted, now);
+            return slept;
+        }
+        std::this_thread::sleep_for(wait);
+        slept += wait;
+    }
+}
+
+void MothershipRateLimiter::PauseUntil(Clock::time_point until) {
+    pausedUntil = std::max(pausedUntil, until);
+}
+
+bool MothershipRateLimiter::ApplyRetryAfter(const std::string& headerValue, Clock::time_point now) {
+    double seconds = 0.0;
+    if (!ParseRetryAfter(headerValue, seconds)) {
+        return false;
+    }
+    PauseUntil(now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds)));
+    return true;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+// Token bucket limiting requests per second, with an additional hard
+// pause honouring the server's Retry-After.
+class MothershipRateLimiter {
+public:
+    typedef std::chrono::steady_clock Clock;
+    // Longest pause a Retry-After can impose; longer ones are cut to it.
+    static const int maxRetryAfterSeconds = 3600;
+
+    // ratePerSecond <= 0 disables the bucket; Retry-After pauses still apply.
+    explicit MothershipRateLimiter(double ratePerSecond = 0.0, double burst = 1.0);
+
+    // Time to wait before `tokens` may be taken. Zero when available now.
+    Clock::duration WaitTime(double tokens, Clock::time_point now = Clock::now());
+    // Takes the tokens if available, without waiting.
+    bool TryAcquire(double tokens, Clock::time_point now = Clock::now());
+    // Blocks until the tokens are available, then takes them. Returns the time slept.
+    Clock::duration Acquire(double tokens);
+
+    // Holds every acquisition until `until`; earlier deadlines are ignored.
+    void PauseUntil(Clock::time_point until);
+    // Applies a Retry-After header value (delta-seconds or HTTP-date).
+    bool ApplyRetryAfter(const std::string& headerValue, Clock::time_point now = Clock::now());
+
+    void SetRate(double ratePerSecond, double burst);
+    inline double Rate() const {
+        return rate;
+    }
+    inline Clock::time_point PausedUntil() const {
+        return pausedUntil;
+    }
+
+private:
+    void Refill(Clock::time_point now);
+
+    double rate;
+    double burst;
+    double tokens;
+    Clock::time_point lastRefill;
+    Clock::time_point pausedUntil;
+};
+
+// Parses a Retry-After value into seconds from now, at most
+// MothershipRateLimiter::maxRetryAfterSeconds. False if malformed or if the
+// number does not fit in 64 bits.
+bool ParseRetryAfter(const std::string& headerValue, double& seconds);
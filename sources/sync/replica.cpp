@@ -0,0 +1,82 @@
+#include "sync/replica.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <random>
+
+#include "storage/data_directory.h"
+
+namespace {
+
+std::atomic<uint64_t> lamportClock{0};
+std::mutex deviceMutex;
+std::string localDevice;
+
+std::mt19937_64& Random() {
+    thread_local std::mt19937_64 rng([] {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) ^ device();
+    }());
+    return rng;
+}
+
+std::string LoadOrCreateDevice() {
+    if (const char* env = std::getenv("MOTHERSHIP_DEVICE_ID"); env && *env) {
+        return env;
+    }
+    std::string path = MothershipDataPath("device_id");
+    std::string device;
+    {
+        std::ifstream in(path);
+        std::getline(in, device);
+    }
+    if (device.empty()) {
+        device = MothershipNewId();
+        std::ofstream out(path, std::ios::trunc);
+        out << device << "\n";
+    }
+    return device;
+}
+
+} // namespace
+
+const std::string& MothershipLocalDevice() {
+    std::lock_guard<std::mutex> lock(deviceMutex);
+    if (localDevice.empty()) {
+        localDevice = LoadOrCreateDevice();
+    }
+    return localDevice;
+}
+
+void MothershipSetLocalDevice(const std::string& device) {
+    std::lock_guard<std::mutex> lock(deviceMutex);
+    localDevice = device;
+}
+
+std::string MothershipNewId() {
+    static const char digits[] = "0123456789abcdef";
+    std::string id(32, '0');
+    uint64_t hi = Random()();
+    uint64_t lo = Random()();
+    for (int i = 0; i < 16; ++i) {
+        id[i] = digits[(hi >> (60 - 4 * i)) & 0xf];
+        id[16 + i] = digits[(lo >> (60 - 4 * i)) & 0xf];
+    }
+    return id;
+}
+
+uint64_t MothershipClockTick() {
+    return lamportClock.fetch_add(1) + 1;
+}
+
+void MothershipClockObserve(uint64_t remote) {
+    uint64_t current = lamportClock.load();
+    while (current < remote && !lamportClock.compare_exchange_weak(current, remote)) {
+    }
+}
+
+uint64_t MothershipClockNow() {
+    return lamportClock.load();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Identity of this Mothership installation and its Lamport clock, used to
+// order concurrent edits made on different devices.
+
+// Stable device id, persisted as "device_id" in the data directory.
+// $MOTHERSHIP_DEVICE_ID overrides it.
+const std::string& MothershipLocalDevice();
+void MothershipSetLocalDevice(const std::string& device);
+
+// Random 128-bit id rendered as 32 hex digits.
+std::string MothershipNewId();
+
+// Advances the local logical clock and returns the new value.
+uint64_t MothershipClockTick();
+// Moves the clock past a value observed from another replica.
+void MothershipClockObserve(uint64_t remote);
+uint64_t MothershipClockNow();
+
+// Total order over (clock, device) pairs; ties are broken by device id.
+struct MothershipStamp {
+    uint64_t clock = 0;
+    std::string device;
+
+    inline bool operator<(const MothershipStamp& other) const {
+        return clock != other.clock ? clock < other.clock : device < other.device;
+    }
+    inline bool operator==(const MothershipStamp& other) const {
+        return clock == other.clock && device == other.device;
+    }
+};
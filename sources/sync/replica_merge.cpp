@@ -0,0 +1,204 @@
+#include "sync/replica_merge.h"
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+inline MothershipStamp TimeframeStamp(const SingleTimeframe& timeframe) {
+    return MothershipStamp{timeframe.clock, timeframe.originDevice};
+}
+
+// True when `remote` is above `local` in the timeframe join order.
+bool RemoteWins(const SingleTimeframe& local, const SingleTimeframe& remote) {
+    if (local.StateRank() != remote.StateRank()) {
+        return local.StateRank() < remote.StateRank();
+    }
+    if (local.clock != remote.clock) {
+        return local.clock < remote.clock;
+    }
+    if (local.endTime != remote.endTime) {
+        return local.endTime < remote.endTime;
+    }
+    return local.startTime < remote.startTime;
+}
+
+inline bool TimeframeBefore(const SingleTimeframe& a, const SingleTimeframe& b) {
+    return a.startTime != b.startTime ? a.startTime < b.startTime : a.id < b.id;
+}
+
+uint64_t MaxClock(const MothershipData& data) {
+    uint64_t clock = 0;
+    for (auto& [title, task] : data.tasks) {
+        clock = std::max(clock, task.stamp.clock);
+        for (auto& [index, timeframe] : task.timeFrames) {
+            clock = std::max(clock, timeframe.clock);
+        }
+    }
+    for (auto& [title, stamp] : data.tombstones) {
+        clock = std::max(clock, stamp.clock);
+    }
+    return clock;
+}
+
+// Drops what the tombstone covers. Returns false if nothing of the task survives.
+bool ApplyTombstone(MothershipTask& task, const MothershipStamp& tombstone, MothershipMergeStats& stats) {
+    bool survives = tombstone < task.stamp;
+    for (auto& [index, timeframe] : task.timeFrames) {
+        if (tombstone < TimeframeStamp(timeframe)) {
+            survives = true;
+            break;
+        }
+    }
+    if (!survives) {
+        return false;
+    }
+    size_t before = task.timeFrames.size();
+    std::erase_if(task.timeFrames, [&](const auto& entry) {
+        return !(tombstone < TimeframeStamp(entry.second));
+    });
+    if (task.timeFrames.size() != before) {
+        stats.timeframesErased += before - task.timeFrames.size();
+        // Renumber so indices stay dense.
+        std::map<int, SingleTimeframe> renumbered;
+        int index = 0;
+        for (auto& [oldIndex, timeframe] : task.timeFrames) {
+            renumbered.emplace_hint(renumbered.end(), index++, std::move(timeframe));
+        }
+        task.timeFrames = std::move(renumbered);
+        task.currentTimeframe = task.timeFrames.empty() ? -1 : index - 1;
+        task.CalculateTotalTime();
+        task.InvalidateAggregates();
+    }
+    return true;
+}
+
+} // namespace
+
+MothershipMergeStats MergeTask(MothershipTask& local, const MothershipTask& remote) {
+    MothershipMergeStats stats;
+    if (local.stamp < remote.stamp) {
+        local.color = remote.color;
+        local.stamp = remote.stamp;
+    }
+
+    std::unordered_map<std::string_view, SingleTimeframe*> byId;
+    byId.reserve(local.timeFrames.size());
+    for (auto& [index, timeframe] : local.timeFrames) {
+        byId.emplace(timeframe.id, &timeframe);
+    }
+
+    std::vector<const SingleTimeframe*> incoming;
+    for (auto& [index, timeframe] : remote.timeFrames) {
+        auto it = byId.find(timeframe.id);
+        if (it == byId.end()) {
+            incoming.push_back(&timeframe);
+        } else if (RemoteWins(*it->second, timeframe)) {
+            *it->second = timeframe;
+            stats.timeframesUpdated += 1;
+        }
+    }
+    if (incoming.empty()) {
+        if (stats.timeframesUpdated > 0) {
+            local.CalculateTotalTime();
+            local.InvalidateAggregates();
+        }
+        return stats;
+    }
+    stats.timeframesAdded = incoming.size();
+
+    // Both sides are normally already ordered by start time, which makes
+    // this a linear two-way merge; sort only if an input is out of order.
+    std::vector<SingleTimeframe> mine;
+    mine.reserve(local.timeFrames.size());
+    for (auto& [index, timeframe] : local.timeFrames) {
+        mine.push_back(std::move(timeframe));
+    }
+    if (!std::is_sorted(mine.begin(), mine.end(), TimeframeBefore)) {
+        std::sort(mine.begin(), mine.end(), TimeframeBefore);
+    }
+    auto pointerBefore = [](const SingleTimeframe* a, const SingleTimeframe* b) { return TimeframeBefore(*a, *b); };
+    if (!std::is_sorted(incoming.begin(), incoming.end(), pointerBefore)) {
+        std::sort(incoming.begin(), incoming.end(), pointerBefore);
+    }
+
+    std::map<int, SingleTimeframe> merged;
+    int index = 0;
+    size_t a = 0;
+    size_t b = 0;
+    while (a < mine.size() || b < incoming.size()) {
+        if (b == incoming.size() || (a < mine.size() && TimeframeBefore(mine[a], *incoming[b]))) {
+            merged.emplace_hint(merged.end(), index++, std::move(mine[a++]));
+        } else {
+            merged.emplace_hint(merged.end(), index++, *incoming[b++]);
+        }
+    }
+    local.timeFrames = std::move(merged);
+
+    // Point at the latest running timeframe, or the last one if none runs.
+    local.currentTimeframe = index - 1;
+    for (auto it = local.timeFrames.rbegin(); it != local.timeFrames.rend(); ++it) {
+        if (it->second.Started()) {
+            local.currentTimeframe = it->first;
+            break;
+        }
+    }
+    local.CalculateTotalTime();
+    local.InvalidateAggregates();
+    return stats;
+}
+
+MothershipMergeStats MergeReplica(MothershipData& local, const MothershipData& remote) {
+    MothershipMergeStats stats;
+    MothershipClockObserve(MaxClock(remote));
+
+    // Tombstones: pointwise maximum, as a merge-join over the sorted maps.
+    auto lt = local.tombstones.begin();
+    for (auto& [title, stamp] : remote.tombstones) {
+        while (lt != local.tombstones.end() && lt->first < title) {
+            ++lt;
+        }
+        if (lt != local.tombstones.end() && lt->first == title) {
+            if (lt->second < stamp) {
+                lt->second = stamp;
+            }
+        } else {
+            lt = local.tombstones.emplace_hint(lt, title, stamp);
+        }
+    }
+
+    // Tasks: union by title, merging tasks present on both sides.
+    auto li = local.tasks.begin();
+    for (auto& [title, task] : remote.tasks) {
+        while (li != local.tasks.end() && li->first < title) {
+            ++li;
+        }
+        if (li != local.tasks.end() && li->first == title) {
+            MothershipMergeStats taskStats = MergeTask(li->second, task);
+            stats.timeframesAdded += taskStats.timeframesAdded;
+            stats.timeframesUpdated += taskStats.timeframesUpdated;
+        } else {
+            li = local.tasks.emplace_hint(li, title, task);
+            stats.tasksAdded += 1;
+            stats.timeframesAdded += task.timeFrames.size();
+        }
+    }
+
+    // Apply tombstones to the merged tasks.
+    auto ti = local.tombstones.begin();
+    for (auto it = local.tasks.begin(); it != local.tasks.end();) {
+        while (ti != local.tombstones.end() && ti->first < it->first) {
+            ++ti;
+        }
+        if (ti != local.tombstones.end() && ti->first == it->first && !ApplyTombstone(it->second, ti->second, stats)) {
+            stats.tasksErased += 1;
+            it = local.tasks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    local.InvalidateIndex();
+    return stats;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+#include "mothership_data.h"
+
+struct MothershipMergeStats {
+    size_t tasksAdded = 0;
+    size_t tasksErased = 0;
+    size_t timeframesAdded = 0;
+    size_t timeframesUpdated = 0;
+    size_t timeframesErased = 0;
+};
+
+// Convergent (state-based CRDT) merge of two replicas' histories.
+//
+// Timeframes are a grow-only set keyed by id; two versions of one
+// timeframe join on the idle < running < finished lattice, then on the
+// logical clock, then on the times themselves. Task color is a
+// last-writer-wins register ordered by MothershipStamp. Erasure is a
+// tombstone that hides everything stamped at or before it.
+//
+// The result depends only on the union of both states, so replicas that
+// have seen the same changes end up identical whatever the merge order.
+// Runs in time linear in the number of tasks and timeframes.
+MothershipMergeStats MergeReplica(MothershipData& local, const MothershipData& remote);
+
+// Merges one task's remote version into the local one (same title).
+MothershipMergeStats MergeTask(MothershipTask& local, const MothershipTask& remote);
@@ -0,0 +1,317 @@
+#include "sync/sync_client.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <set>
+
+#include "metrics.h"
+#include "storage/data_directory.h"
+#include "storage/serialization.h"
+#include "sync/replica_merge.h"
+
+namespace {
+
+std::string ResolveBaseUrl(const std::string& baseUrl) {
+    std::string url = baseUrl;
+    if (url.empty()) {
+        const char* env = std::getenv("MOTHERSHIP_SERVER_URL");
+        url = (env && *env) ? env : "http://127.0.0.1:8080";
+    }
+    while (!url.empty() && url.back() == '/') {
+        url.pop_back();
+    }
+    return url;
+}
+
+double EnvDouble(const char* name, double fallback) {
+    const char* env = std::getenv(name);
+    return (env && *env) ? std::atof(env) : fallback;
+}
+
+} // namespace
+
+MothershipSyncClient::MothershipSyncClient(const std::string& baseUrl, const std::string& cachePath)
+    : baseUrl(ResolveBaseUrl(baseUrl)),
+      cache(cachePath.empty() ? MothershipDataPath("http_cache.json") : cachePath),
+      http(&cache) {
+    cache.Load();
+    double rate = EnvDouble("MOTHERSHIP_SYNC_RATE", 0.0);
+    if (rate > 0.0) {
+        limiter.SetRate(rate, EnvDouble("MOTHERSHIP_SYNC_BURST", std::max(1.0, rate / 4.0)));
+    }
+}
+
+MothershipSyncClient::~MothershipSyncClient() {
+    if (cache.Dirty()) {
+        cache.Save();
+    }
+}
+
+bool MothershipSyncClient::PullSummary(std::string& json) {
+    return Pull("/api/summary", json);
+}
+
+bool MothershipSyncClient::PullTasks(std::string& json) {
+    return Pull("/api/tasks", json);
+}
+
+bool MothershipSyncClient::Pull(const std::string& path, std::string& json) {
+    if (!http.Get(baseUrl + path, lastResponse) || (!lastResponse.Ok() && !lastResponse.fromCache)) {
+        return false;
+    }
+    json = lastResponse.body;
+    if (cache.Dirty()) {
+        cache.Save();
+    }
+    return true;
+}
+
+void MothershipSyncClient::SetBatchSize(size_t batchSize) {
+    MothershipBatchControllerConfig config;
+    config.minBatch = config.maxBatch = config.initialBatch = batchSize > 0 ? batchSize : 1;
+    config.minConcurrency = config.maxConcurrency = config.initialConcurrency = 1;
+    controller = MothershipBatchController(config);
+}
+
+void MothershipSyncClient::SetBatchController(const MothershipBatchControllerConfig& config) {
+    controller = MothershipBatchController(config);
+}
+
+bool MothershipSyncClient::UploadEvents(const std::vector<MothershipSyncEvent>& events, MothershipUploadStats* stats) {
+    struct Batch {
+        size_t begin;
+        size_t end;
+        int attempts;
+    };
+
+    MothershipMetrics& metrics = MothershipMetrics::Instance();
+    const std::string url = baseUrl + "/api/sync/events";
+    std::deque<Batch> retries;
+    size_t next = 0;
+    std::vector<Batch> round;
+    std::vector<std::string> bodies;
+    std::vector<MothershipHttpResponse> responses;
+    acceptedRecently.clear();
+
+    while (next < events.size() || !retries.empty()) {
+        round.clear();
+        bodies.clear();
+        size_t width = static_cast<size_t>(controller.Concurrency());
+        while (round.size() < width && !retries.empty()) {
+            round.push_back(retries.front());
+            retries.pop_front();
+        }
+        while (round.size() < width && next < events.size()) {
+            size_t end = std::min(events.size(), next + controller.BatchSize());
+            round.push_back({next, end, 0});
+            next = end;
+        }
+        for (const Batch& batch : round) {
+            bodies.push_back(EncodeEventBatch(events, batch.begin, batch.end));
+        }
+
+        auto waited = limiter.Acquire(static_cast<double>(round.size()));
+        metrics.SetGauge("sync.rate_limit_wait_ms", std::chrono::duration<double, std::milli>(waited).count());
+
+        auto roundStart = std::chrono::steady_clock::now();
+        http.PostMany(url, bodies, "application/json", responses);
+        auto roundEnd = std::chrono::steady_clock::now();
+        double roundSeconds = std::chrono::duration<double>(roundEnd - roundStart).count();
+
+        size_t delivered = 0;
+        size_t accepted = 0;
+        size_t failures = 0;
+        bool rateLimited = false;
+        for (size_t i = 0; i < round.size(); ++i) {
+            const MothershipHttpResponse& response = responses[i];
+            if (response.Ok()) {
+                delivered += round[i].end - round[i].begin;
+                accepted += 1;
+                if (stats) {
+                    stats->batches += 1;
+                    stats->batchLatenciesMs.push_back(response.totalMs);
+                }
+                continue;
+            }
+            failures += 1;
+            if (response.status == 429 || response.status == 503) {
+                std::string retryAfter = response.Header("retry-after");
+                if (response.status == 429 || !retryAfter.empty()) {
+                    rateLimited = true;
+                }
+                if (limiter.ApplyRetryAfter(retryAfter, roundEnd)) {
+                    metrics.Increment("sync.retry_after");
+                }
+            }
+            Batch retry = round[i];
+            retry.attempts += 1;
+            if (retry.attempts > maxRetries) {
+                lastResponse = response;
+                return false;
+            }
+            retries.push_back(retry);
+        }
+        if (!responses.empty()) {
+            lastResponse = responses.back();
+        }
+
+        controller.OnRound(delivered, roundSeconds, failures, rateLimited);
+        AdaptRate(accepted, rateLimited, roundStart, roundEnd);
+        metrics.Increment("sync.events_sent", static_cast<long long>(delivered));
+        metrics.Increment("sync.failed_attempts", static_cast<long long>(failures));
+        if (rateLimited) {
+            metrics.Increment("sync.rate_limited");
+        }
+        if (stats) {
+            stats->eventsSent += delivered;
+            stats->failedAttempts += failures;
+            stats->rateLimited += rateLimited ? 1 : 0;
+            stats->rounds += 1;
+        }
+    }
+    return true;
+}
+
+void MothershipSyncClient::AdaptRate(size_t accepted, bool rateLimited, std::chrono::steady_clock::time_point roundStart,
+                                     std::chrono::steady_clock::time_point roundEnd) {
+    // Pruned before this round goes in, so a round longer than the window
+    // still counts.
+    while (!acceptedRecently.empty() && roundEnd - acceptedRecently.front().first > std::chrono::seconds(1)) {
+        acceptedRecently.pop_front();
+    }
+    acceptedRecently.emplace_back(roundStart, accepted);
+    if (!adaptiveRate) {
+        return;
+    }
+    double rate = limiter.Rate();
+    if (rateLimited) {
+        // Servers count quotas per second: aim just below what it accepted
+        // in the second before refusing, and below the current rate. The
+        // samples start after the last refusal, so the Retry-After pause
+        // does not thin them out.
+        size_t recent = 0;
+        for (auto& [at, count] : acceptedRecently) {
+            recent += count;
+        }
+        double target = std::max(1.0, 0.9 * static_cast<double>(recent));
+        rate = rate > 0.0 ? std::min(target, 0.9 * rate) : target;
+        acceptedRecently.clear();
+    } else if (rate > 0.0) {
+        rate *= 1.0 + 0.05 * std::chrono::duration<double>(roundEnd - roundStart).count();
+    } else {
+        return;
+    }
+    limiter.SetRate(rate, std::max(static_cast<double>(controller.Concurrency()), rate / 4.0));
+    MothershipMetrics::Instance().SetGauge("sync.rate_limit_rps", rate);
+}
+
+bool MothershipSyncClient::PostJson(const std::string& path, const nlohmann::json& body, nlohmann::json& reply,
+                                    MothershipReconcileStats* stats) {
+    std::string payload = body.dump();
+    bool ok = http.Post(baseUrl + path, payload, "application/json", lastResponse) && lastResponse.Ok();
+    if (stats) {
+        stats->requests += 1;
+        stats->bytesSent += payload.size();
+        stats->bytesReceived += lastResponse.body.size();
+    }
+    if (!ok) {
+        return false;
+    }
+    reply = nlohmann::json::parse(lastResponse.body, nullptr, false);
+    return !reply.is_discarded() && reply.is_object();
+}
+
+bool MothershipSyncClient::Reconcile(MothershipData& data, MothershipReconcileStats* stats) {
+    MothershipReconcileStats localStats;
+    if (!stats) {
+        stats = &localStats;
+    }
+    MothershipMerkleTree tree;
+    tree.Build(data);
+
+    std::vector<std::string> frontier{""};
+    std::vector<std::string> differing;
+    nlohmann::json reply;
+    while (!frontier.empty()) {
+        if (!PostJson("/api/sync/merkle", {{"nodes", frontier}}, reply, stats)) {
+            return false;
+        }
+        const nlohmann::json& remoteNodes = reply.value("nodes", nlohmann::json::object());
+        std::vector<std::string> next;
+        for (const std::string& key : frontier) {
+            auto node = remoteNodes.find(key);
+            uint64_t remoteHash = node != remoteNodes.end() ? MerkleHashFromHex(node->value("hash", "0")) : 0;
+            if (remoteHash == tree.Hash(key)) {
+                continue;
+            }
+            if (MothershipMerkleTree::IsLeaf(key)) {
+                differing.push_back(key);
+                continue;
+            }
+            // Union of both sides' children, keeping those that differ.
+            std::map<std::string, uint64_t> remoteChildren;
+            if (node != remoteNodes.end()) {
+                nlohmann::json children = node->value("children", nlohmann::json::object());
+                for (auto& [child, hash] : children.items()) {
+                    remoteChildren[child] = MerkleHashFromHex(hash.get<std::string>());
+                }
+            }
+            static const MothershipMerkleTree::_Children none;
+            const MothershipMerkleTree::_Children* localChildren = tree.Children(key);
+            if (!localChildren) {
+                localChildren = &none;
+            }
+            std::set<std::string> keys;
+            for (auto& [child, hash] : *localChildren) {
+                keys.insert(child);
+            }
+            for (auto& [child, hash] : remoteChildren) {
+                keys.insert(child);
+            }
+            for (const std::string& child : keys) {
+                auto l = localChildren->find(child);
+                auto r = remoteChildren.find(child);
+                uint64_t localHash = l != localChildren->end() ? l->second : 0;
+                uint64_t childRemoteHash = r != remoteChildren.end() ? r->second : 0;
+                if (localHash == childRemoteHash) {
+                    continue;
+                }
+                if (MothershipMerkleTree::IsLeaf(child)) {
+                    differing.push_back(child);
+                } else {
+                    next.push_back(child);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+
+    if (differing.empty()) {
+        stats->inSync = true;
+        return true;
+    }
+
+    // Pull the remote versions of the differing leaves and merge them in.
+    if (!PostJson("/api/sync/leaves", {{"leaves", differing}}, reply, stats)) {
+        return false;
+    }
+    MothershipData remote;
+    if (!DataFromJson(reply, remote)) {
+        return false;
+    }
+    MergeReplica(data, remote);
+    stats->leavesPulled += differing.size();
+
+    // Push the merged local versions so the server converges too.
+    MothershipData partial = ExtractLeaves(data, differing);
+    if (!PostJson("/api/sync/history", DataToJson(partial), reply, stats)) {
+        return false;
+    }
+    stats->leavesPushed += differing.size();
+
+    tree.Build(data);
+    stats->inSync = MerkleHashFromHex(reply.value("root", "0")) == tree.Hash("");
+    return true;
+}
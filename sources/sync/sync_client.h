@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sync/batch_controller.h"
+#include "sync/http_cache.h"
+#include "sync/http_client.h"
+#include "sync/merkle_history.h"
+#include "sync/rate_limiter.h"
+#include "sync/sync_event.h"
+
+struct MothershipUploadStats {
+    size_t eventsSent = 0;
+    size_t batches = 0;
+    size_t failedAttempts = 0;
+    size_t rateLimited = 0;
+    size_t rounds = 0;
+    // Request latency of every successful batch, each timed on its own.
+    std::vector<double> batchLatenciesMs;
+};
+
+struct MothershipReconcileStats {
+    size_t requests = 0;
+    size_t bytesSent = 0;
+    size_t bytesReceived = 0;
+    size_t leavesPulled = 0;
+    size_t leavesPushed = 0;
+    // True when both sides ended with the same root hash.
+    bool inSync = false;
+};
+
+// Talks to the Mothership website. Pulls go through the response cache,
+// so a periodic refresh of unchanged data is a header round trip.
+class MothershipSyncClient {
+public:
+    // Base URL such as "https://example.org"; $MOTHERSHIP_SERVER_URL overrides
+    // the default when an empty string is passed.
+    explicit MothershipSyncClient(const std::string& baseUrl = std::string(),
+                                  const std::string& cachePath = std::string());
+    ~MothershipSyncClient();
+
+    bool PullSummary(std::string& json);
+    bool PullTasks(std::string& json);
+
+    // Uploads events in rounds of Concurrency() parallel batches of
+    // BatchSize() events, both steered by the batch controller and paced by
+    // the rate limiter. A batch is retried up to MaxRetries() times.
+    bool UploadEvents(const std::vector<MothershipSyncEvent>& events, MothershipUploadStats* stats = nullptr);
+
+    // Anti-entropy: walks the server's Merkle tree level by level, descending
+    // only into nodes whose hash differs, then pulls and merges the differing
+    // leaves and pushes the local versions back. A history already in sync
+    // costs one request; otherwise one per tree level plus two.
+    bool Reconcile(MothershipData& data, MothershipReconcileStats* stats = nullptr);
+
+    // Fixed batch size and a single request in flight; disables adaptation.
+    void SetBatchSize(size_t batchSize);
+    // Adaptive (AIMD) batch size and concurrency within the config's bounds.
+    void SetBatchController(const MothershipBatchControllerConfig& config);
+
+    inline size_t BatchSize() const {
+        return controller.BatchSize();
+    }
+    inline int Concurrency() const {
+        return controller.Concurrency();
+    }
+    inline const MothershipBatchController& BatchController() const {
+        return controller;
+    }
+    inline MothershipRateLimiter& RateLimiter() {
+        return limiter;
+    }
+    // Uploads are paced by the rate limiter's token bucket, seeded from
+    // $MOTHERSHIP_SYNC_RATE (requests per second) and $MOTHERSHIP_SYNC_BURST.
+    // With adaptive pacing (the default) a 429 or Retry-After sets the rate
+    // just below what the server accepted over the last second, and clean
+    // rounds raise it again by 5% per second, so the server's limit is
+    // found once instead of hit over and over.
+    inline void SetAdaptiveRate(bool adaptive) {
+        adaptiveRate = adaptive;
+    }
+    inline void SetMaxRetries(int maxRetries) {
+        this->maxRetries = maxRetries;
+    }
+    inline int MaxRetries() const {
+        return maxRetries;
+    }
+
+    inline const std::string& BaseUrl() const {
+        return baseUrl;
+    }
+    inline const MothershipHttpResponse& LastResponse() const {
+        return lastResponse;
+    }
+    inline MothershipHttpCache& Cache() {
+        return cache;
+    }
+
+private:
+    bool Pull(const std::string& path, std::string& json);
+    bool PostJson(const std::string& path, const nlohmann::json& body, nlohmann::json& reply,
+                  MothershipReconcileStats* stats);
+    void AdaptRate(size_t accepted, bool rateLimited, std::chrono::steady_clock::time_point roundStart,
+                   std::chrono::steady_clock::time_point roundEnd);
+
+    std::string baseUrl;
+    MothershipHttpCache cache;
+    MothershipHttpClient http;
+    MothershipHttpResponse lastResponse;
+    MothershipBatchController controller;
+    MothershipRateLimiter limiter;
+    bool adaptiveRate = true;
+    // Requests accepted per round (its start and count) over about the last
+    // second, since the upload started or the server last refused one.
+    std::deque<std::pair<std::chrono::steady_clock::time_point, size_t>> acceptedRecently;
+    int maxRetries = 3;
+};
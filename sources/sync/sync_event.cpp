@@ -0,0 +1,46 @@
+#include "sync/sync_event.h"
+
+namespace {
+
+const char* KindName(MothershipSyncEvent::Kind kind) {
+    switch (kind) {
+        case MothershipSyncEvent::AddTask: return "add";
+        case MothershipSyncEvent::EraseTask: return "erase";
+        case MothershipSyncEvent::StartTimeframe: return "start";
+        case MothershipSyncEvent::StopTimeframe: return "stop";
+    }
+    return "start";
+}
+
+MothershipSyncEvent::Kind KindFromName(const std::string& name) {
+    if (name == "add") return MothershipSyncEvent::AddTask;
+    if (name == "erase") return MothershipSyncEvent::EraseTask;
+    if (name == "stop") return MothershipSyncEvent::StopTimeframe;
+    return MothershipSyncEvent::StartTimeframe;
+}
+
+} // namespace
+
+void to_json(nlohmann::json& j, const MothershipSyncEvent& event) {
+    j = {
+        {"seq", event.sequence},
+        {"kind", KindName(event.kind)},
+        {"task", event.task},
+        {"ts", event.timestamp}
+    };
+}
+
+void from_json(const nlohmann::json& j, MothershipSyncEvent& event) {
+    event.sequence = j.value("seq", uint64_t(0));
+    event.kind = KindFromName(j.value("kind", std::string("start")));
+    event.task = j.value("task", std::string());
+    event.timestamp = j.value("ts", 0LL);
+}
+
+std::string EncodeEventBatch(const std::vector<MothershipSyncEvent>& events, size_t begin, size_t end) {
+    nlohmann::json batch = nlohmann::json::array();
+    for (size_t i = begin; i < end && i < events.size(); ++i) {
+        batch.push_back(events[i]);
+    }
+    return nlohmann::json{{"events", std::move(batch)}}.dump();
+}
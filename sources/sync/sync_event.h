@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+// A single change recorded locally and uploaded to the website.
+struct MothershipSyncEvent {
+    enum Kind {
+        AddTask,
+        EraseTask,
+        StartTimeframe,
+        StopTimeframe
+    };
+
+    uint64_t sequence = 0;
+    Kind kind = StartTimeframe;
+    std::string task;
+    long long timestamp = 0; // unix milliseconds
+};
+
+void to_json(nlohmann::json& j, const MothershipSyncEvent& event);
+void from_json(const nlohmann::json& j, MothershipSyncEvent& event);
+
+// Serializes events[begin, end) as an upload batch body.
+std::string EncodeEventBatch(const std::vector<MothershipSyncEvent>& events, size_t begin, size_t end);
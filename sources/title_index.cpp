@@ -0,0 +1,76 @@
+#include "title_index.h"
+
+#include <algorithm>
+
+#include "mothership_data.h"
+
+namespace {
+
+MothershipTitleIndex::_Postings::iterator Find(MothershipTitleIndex::_Postings& list, const std::string& title) {
+    return std::lower_bound(list.begin(), list.end(), title,
+                            [](const MothershipTitleIndex::Entry& e, const std::string& t) { return e.task->title < t; });
+}
+
+} // namespace
+
+uint64_t MothershipTitleIndex::ClassMask(const std::string& title) {
+    uint64_t mask = 0;
+    for (unsigned char c : title) {
+        mask |= uint64_t(1) << Class(c);
+    }
+    return mask;
+}
+
+void MothershipTitleIndex::Clear() {
+    arena.clear();
+    deadBytes = 0;
+    for (_Postings& list : postings) {
+        list.clear();
+    }
+}
+
+uint32_t MothershipTitleIndex::Store(const std::string& title) {
+    uint32_t offset = static_cast<uint32_t>(arena.size());
+    for (unsigned char c : title) {
+        arena.push_back(c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : static_cast<char>(c));
+    }
+    arena.push_back('\0');
+    return offset;
+}
+
+void MothershipTitleIndex::Append(MothershipTask* task) {
+    uint64_t mask = ClassMask(task->title);
+    Entry entry{task, Store(task->title), mask};
+    for (int c = 0; c < classes; ++c) {
+        if (mask & (uint64_t(1) << c)) {
+            postings[c].push_back(entry);
+        }
+    }
+}
+
+void MothershipTitleIndex::Insert(MothershipTask* task) {
+    uint64_t mask = ClassMask(task->title);
+    Entry entry{task, Store(task->title), mask};
+    for (int c = 0; c < classes; ++c) {
+        if (mask & (uint64_t(1) << c)) {
+            postings[c].insert(Find(postings[c], task->title), entry);
+        }
+    }
+}
+
+void MothershipTitleIndex::Erase(const std::string& title) {
+    uint64_t mask = ClassMask(title);
+    bool counted = false;
+    for (int c = 0; c < classes; ++c) {
+        if (mask & (uint64_t(1) << c)) {
+            auto it = Find(postings[c], title);
+            if (it != postings[c].end() && it->task->title == title) {
+                if (!counted) {
+                    deadBytes += title.size() + 1;
+                    counted = true;
+                }
+                postings[c].erase(it);
+            }
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class MothershipTask;
+
+// Index over task titles for fuzzy search. Titles are copied, lower-cased
+// and NUL-terminated, into one contiguous arena so scans walk memory
+// instead of chasing task pointers. For every character class (a-z, 0-9,
+// and one shared class for everything else) a postings list holds the
+// titles containing it, in title order.
+class MothershipTitleIndex {
+public:
+    struct Entry {
+        MothershipTask* task;
+        uint32_t offset; // of the title in the arena
+        uint64_t classes; // bit Class(c) set for every character in the title
+    };
+    typedef std::vector<Entry> _Postings;
+
+    void Clear();
+    // Adds a task after every title already present; for bulk rebuilds.
+    void Append(MothershipTask* task);
+    void Insert(MothershipTask* task);
+    void Erase(const std::string& title);
+
+    inline const _Postings& Postings(unsigned char c) const {
+        return postings[Class(c)];
+    }
+    inline const char* Title(uint32_t offset) const {
+        return arena.data() + offset;
+    }
+    // True once erased titles take more room than live ones.
+    inline bool NeedsCompaction() const {
+        return deadBytes > 4096 && deadBytes > arena.size() / 2;
+    }
+
+    static uint64_t ClassMask(const std::string& title);
+    static inline int Class(unsigned char c) {
+        if (c >= 'a' && c <= 'z') return c - 'a';
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= '0' && c <= '9') return 26 + (c - '0');
+        return 36;
+    }
+
+private:
+    static const int classes = 37;
+
+    uint32_t Store(const std::string& title);
+
+    std::vector<char> arena;
+    size_t deadBytes = 0;
+    std::array<_Postings, classes> postings;
+};
@@ -0,0 +1,86 @@
+#include "title_search.h"
+
+#include <algorithm>
+
+#include "metrics.h"
+
+namespace {
+
+inline char Fold(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Titles are short: a plain loop beats a strchr call per candidate.
+inline const char* Find(const char* title, char c) {
+    for (; *title; ++title) {
+        if (*title == c) {
+            return title;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void MothershipTitleSearch::Clear() {
+    query.clear();
+    depth = 0;
+}
+
+void MothershipTitleSearch::Update(MothershipData& data, const std::string& wanted) {
+    if (generation != data.IndexGeneration()) {
+        Clear();
+        generation = data.IndexGeneration();
+    }
+    const MothershipTitleIndex& index = data.TitleIndex();
+
+    size_t common = 0;
+    while (common < query.size() && common < wanted.size() && Fold(query[common]) == Fold(wanted[common])) {
+        ++common;
+    }
+    depth = std::min(common, depth);
+    query = wanted;
+    for (size_t i = depth; i < query.size(); ++i) {
+        Extend(index, Fold(query[i]));
+    }
+
+    static auto& searches = MothershipMetrics::Instance().Counter("search.updates");
+    searches.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MothershipTitleSearch::Extend(const MothershipTitleIndex& index, char c) {
+    if (levels.size() <= depth) {
+        levels.resize(depth + 1);
+    }
+    _Candidates& next = levels[depth];
+    next.clear();
+    depth += 1;
+    if (c == '\0') {
+        return;
+    }
+    const char* arena = index.Title(0);
+    if (depth == 1) {
+        const MothershipTitleIndex::_Postings& postings = index.Postings(static_cast<unsigned char>(c));
+        next.reserve(postings.size());
+        for (const MothershipTitleIndex::Entry& entry : postings) {
+            // Classes other than letters and digits are shared, so the
+            // character may still be missing.
+            if (const char* found = Find(arena + entry.offset, c)) {
+                next.push_back(Candidate{entry.task, static_cast<uint32_t>(found - arena + 1), entry.classes});
+            }
+        }
+    } else {
+        const _Candidates& previous = levels[depth - 2];
+        uint64_t bit = uint64_t(1) << MothershipTitleIndex::Class(static_cast<unsigned char>(c));
+        next.reserve(previous.size());
+        for (const Candidate& candidate : previous) {
+            // Most misses lack the character altogether; skip those without a scan.
+            if (!(candidate.classes & bit)) {
+                continue;
+            }
+            if (const char* found = Find(arena + candidate.end, c)) {
+                next.push_back(Candidate{candidate.task, static_cast<uint32_t>(found - arena + 1), candidate.classes});
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mothership_data.h"
+
+// Fuzzy (subsequence, case-insensitive) task title search over the
+// MothershipTitleIndex kept by MothershipData.
+//
+// Matching is incremental. For every prefix of the query it keeps the
+// candidates together with where their leftmost match ended. A typed
+// character only resumes the scan from there, over the previous
+// prefix's candidates. Backspace drops the last level. Only the first
+// character reads a postings list. Results are in title order.
+class MothershipTitleSearch {
+public:
+    // Brings the results up to date for `query`, reusing every level the
+    // previous query shares with it. Recomputes from scratch after the
+    // set of titles changed.
+    void Update(MothershipData& data, const std::string& query);
+    void Clear();
+
+    inline size_t Count() const {
+        return depth == 0 ? 0 : levels[depth - 1].size();
+    }
+    inline MothershipTask* At(size_t index) const {
+        return levels[depth - 1][index].task;
+    }
+    inline const std::string& Query() const {
+        return query;
+    }
+
+private:
+    struct Candidate {
+        MothershipTask* task;
+        // Arena position just past the character matched by the last query character.
+        uint32_t end;
+        uint64_t classes;
+    };
+    typedef std::vector<Candidate> _Candidates;
+
+    void Extend(const MothershipTitleIndex& index, char c);
+
+    std::string query;
+    // levels[i] answers query[0..i] for i < depth. Deeper levels only keep
+    // their storage, so retyping does not allocate.
+    std::vector<_Candidates> levels;
+    size_t depth = 0;
+    unsigned long long generation = 0;
+};
@@ -0,0 +1,166 @@
+#include "ui/color_manager.h"
+
+#include <algorithm>
+#include <ncurses.h>
+
+#include "metrics.h"
+
+namespace {
+
+// xterm's default RGB for palette index i.
+void PaletteRgb(int i, int& r, int& g, int& b) {
+    static const int system[16][3] = {
+        {0, 0, 0}, {205, 0, 0}, {0, 205, 0}, {205, 205, 0},
+        {0, 0, 238}, {205, 0, 205}, {0, 205, 205}, {229, 229, 229},
+        {127, 127, 127}, {255, 0, 0}, {0, 255, 0}, {255, 255, 0},
+        {92, 92, 255}, {255, 0, 255}, {0, 255, 255}, {255, 255, 255}
+    };
+    if (i < 16) {
+        r = system[i][0];
+        g = system[i][1];
+        b = system[i][2];
+    } else if (i < 232) {
+        static const int levels[6] = {0, 95, 135, 175, 215, 255};
+        int n = i - 16;
+        r = levels[n / 36];
+        g = levels[(n / 6) % 6];
+        b = levels[n % 6];
+    } else {
+        r = g = b = 8 + (i - 232) * 10;
+    }
+}
+
+inline uint32_t PackRgb(const MothershipColor& color) {
+    return (std::min<uint32_t>(color.r, 255) << 16) | (std::min<uint32_t>(color.g, 255) << 8) |
+           std::min<uint32_t>(color.b, 255);
+}
+
+} // namespace
+
+void MothershipColorManager::Init(int reservedPairs) {
+    this->reservedPairs = reservedPairs;
+    paletteSize = COLORS >= 256 ? 256 : (COLORS >= 16 ? 16 : 8);
+    dynamicColors = can_change_color() && COLORS > 16;
+
+    pairCapacity = COLOR_PAIRS > reservedPairs + 1 ? static_cast<size_t>(COLOR_PAIRS - reservedPairs - 1) : 0;
+    // Pair numbers are shorts.
+    pairCapacity = std::min<size_t>(pairCapacity, 32767 - reservedPairs);
+    colorCapacity = dynamicColors ? static_cast<size_t>(std::min(COLORS, 32767) - 16) : 0;
+
+    pairLru.clear();
+    pairIndex.clear();
+    colorLru.clear();
+    colorIndex.clear();
+    pendingColors.clear();
+    pendingPairs.clear();
+    lookup.clear();
+    if (!dynamicColors) {
+        BuildLookupTable();
+    }
+}
+
+void MothershipColorManager::BuildLookupTable() {
+    lookup.assign(32 * 32 * 32, 0);
+    for (int r5 = 0; r5 < 32; ++r5) {
+        for (int g5 = 0; g5 < 32; ++g5) {
+            for (int b5 = 0; b5 < 32; ++b5) {
+                // Centre of the quantization cell.
+                int r = r5 * 8 + 4;
+                int g = g5 * 8 + 4;
+                int b = b5 * 8 + 4;
+                int best = 0;
+                long bestDistance = -1;
+                for (int i = 0; i < paletteSize; ++i) {
+                    int pr, pg, pb;
+                    PaletteRgb(i, pr, pg, pb);
+                    // Weighted for the eye's sensitivity to green.
+                    long distance = 3L * (r - pr) * (r - pr) + 4L * (g - pg) * (g - pg) + 2L * (b - pb) * (b - pb);
+                    if (bestDistance < 0 || distance < bestDistance) {
+                        bestDistance = distance;
+                        best = i;
+                    }
+                }
+                lookup[(r5 << 10) | (g5 << 5) | b5] = static_cast<uint8_t>(best);
+            }
+        }
+    }
+}
+
+std::pair<short, bool> MothershipColorManager::Acquire(_Lru& lru, std::unordered_map<uint32_t, _Lru::iterator>& index,
+                                                       uint32_t key, short firstNumber, size_t capacity) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        lru.splice(lru.begin(), lru, it->second);
+        return {it->second->number, false};
+    }
+    short number;
+    if (lru.size() < capacity) {
+        number = static_cast<short>(firstNumber + lru.size());
+    } else {
+        Slot victim = lru.back();
+        lru.pop_back();
+        index.erase(victim.key);
+        number = victim.number;
+        evictions += 1;
+    }
+    lru.push_front(Slot{key, number});
+    index[key] = lru.begin();
+    return {number, true};
+}
+
+short MothershipColorManager::ColorIndex(const MothershipColor& color) {
+    if (!color.isCustomColor) {
+        if (color.colorCode < 0) {
+            return COLOR_WHITE;
+        }
+        return static_cast<short>(color.colorCode < paletteSize ? color.colorCode : color.colorCode % 8);
+    }
+    uint32_t rgb = PackRgb(color);
+    if (dynamicColors && colorCapacity > 0) {
+        auto [slot, fresh] = Acquire(colorLru, colorIndex, rgb, 16, colorCapacity);
+        if (fresh) {
+            pendingColors.emplace_back(slot, rgb);
+        }
+        return slot;
+    }
+    if (lookup.empty()) {
+        return COLOR_WHITE;
+    }
+    return lookup[((rgb >> 19) & 0x1f) << 10 | ((rgb >> 11) & 0x1f) << 5 | ((rgb >> 3) & 0x1f)];
+}
+
+short MothershipColorManager::Pair(const MothershipColor& color, short background) {
+    if (pairCapacity == 0) {
+        return 0;
+    }
+    short foreground = ColorIndex(color);
+    uint32_t key = (static_cast<uint32_t>(static_cast<uint16_t>(foreground)) << 16) | static_cast<uint16_t>(background);
+    auto [pair, fresh] = Acquire(pairLru, pairIndex, key, static_cast<short>(reservedPairs + 1), pairCapacity);
+    if (fresh) {
+        misses += 1;
+        pendingPairs.emplace_back(pair, key);
+    } else {
+        hits += 1;
+    }
+    return pair;
+}
+
+bool MothershipColorManager::Flush() {
+    if (pendingColors.empty() && pendingPairs.empty()) {
+        return false;
+    }
+    for (auto& [slot, rgb] : pendingColors) {
+        // ncurses color components are 0-1000.
+        init_color(slot, static_cast<short>(((rgb >> 16) & 0xff) * 1000 / 255),
+                   static_cast<short>(((rgb >> 8) & 0xff) * 1000 / 255), static_cast<short>((rgb & 0xff) * 1000 / 255));
+    }
+    for (auto& [pair, key] : pendingPairs) {
+        init_pair(pair, static_cast<short>(key >> 16), static_cast<short>(key & 0xffff));
+    }
+    MothershipMetrics& metrics = MothershipMetrics::Instance();
+    metrics.Increment("ui.color_pairs_defined", static_cast<long long>(pendingPairs.size()));
+    metrics.SetGauge("ui.color_pair_evictions", static_cast<double>(evictions));
+    pendingColors.clear();
+    pendingPairs.clear();
+    return true;
+}
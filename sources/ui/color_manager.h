@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mothership_data.h"
+
+// Maps task colors to ncurses color pairs within the terminal's limits.
+//
+// Standard colors are used as is. Custom RGB colors (components 0-255)
+// get a redefined color slot when the terminal can change colors, and are
+// otherwise quantized to the nearest palette entry through a 32x32x32
+// lookup table built once in Init. Pairs and redefined slots are recycled
+// least-recently-used first.
+//
+// Pair() never calls into ncurses: new definitions are queued and applied
+// by Flush(), which the render model runs once per frame before doupdate.
+// Every visible row looks its color up each frame, so the colors on
+// screen are always the most recently used and are not evicted.
+class MothershipColorManager {
+public:
+    // Pairs [1, reservedPairs] are left to the caller (chrome colors).
+    void Init(int reservedPairs);
+
+    short Pair(const MothershipColor& color, short background = 0);
+    // Palette index a color resolves to, without allocating a pair.
+    short ColorIndex(const MothershipColor& color);
+
+    // Applies queued init_color/init_pair calls. Returns true if any.
+    bool Flush();
+
+    inline size_t Hits() const {
+        return hits;
+    }
+    inline size_t Misses() const {
+        return misses;
+    }
+    inline size_t Evictions() const {
+        return evictions;
+    }
+    inline size_t PairCapacity() const {
+        return pairCapacity;
+    }
+
+private:
+    struct Slot {
+        uint32_t key;
+        short number;
+    };
+    typedef std::list<Slot> _Lru;
+
+    // Looks `key` up in an LRU map, allocating (and possibly evicting) on a miss.
+    // Returns the slot number and whether it was newly assigned.
+    std::pair<short, bool> Acquire(_Lru& lru, std::unordered_map<uint32_t, _Lru::iterator>& index,
+                                   uint32_t key, short firstNumber, size_t capacity);
+    void BuildLookupTable();
+
+    int reservedPairs = 0;
+    int paletteSize = 8;
+    bool dynamicColors = false;
+
+    size_t pairCapacity = 0;
+    _Lru pairLru;
+    std::unordered_map<uint32_t, _Lru::iterator> pairIndex;
+
+    // Redefinable color slots start after the 16 system colors.
+    size_t colorCapacity = 0;
+    _Lru colorLru;
+    std::unordered_map<uint32_t, _Lru::iterator> colorIndex;
+
+    std::vector<uint8_t> lookup; // 32x32x32 -> palette index
+
+    std::vector<std::pair<short, uint32_t>> pendingColors; // slot, rgb
+    std::vector<std::pair<short, uint32_t>> pendingPairs;  // pair, fg << 16 | bg
+
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+};
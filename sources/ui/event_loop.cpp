@@ -0,0 +1,142 @@
+#include "ui/event_loop.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "metrics.h"
+
+MothershipEventLoop::~MothershipEventLoop() {
+    for (int fd : {epollFd, timerFd, signalFd, wakeFd}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+bool MothershipEventLoop::Init() {
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGWINCH);
+    if (sigprocmask(SIG_BLOCK, &signals, nullptr) != 0) {
+        return false;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    signalFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || timerFd < 0 || signalFd < 0 || wakeFd < 0) {
+        return false;
+    }
+    for (int fd : {timerFd, signalFd, wakeFd}) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MothershipEventLoop::WatchInput(int fd) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        return false;
+    }
+    inputFd = fd;
+    return true;
+}
+
+void MothershipEventLoop::SetTick(std::chrono::milliseconds interval, bool aligned) {
+    if (interval == tickInterval) {
+        return;
+    }
+    tickInterval = interval;
+    itimerspec spec{};
+    if (interval.count() > 0) {
+        auto first = interval;
+        if (aligned) {
+            auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch());
+            first = interval - now % interval;
+        }
+        spec.it_value.tv_sec = first.count() / 1000;
+        spec.it_value.tv_nsec = (first.count() % 1000) * 1000000L;
+        spec.it_interval.tv_sec = interval.count() / 1000;
+        spec.it_interval.tv_nsec = (interval.count() % 1000) * 1000000L;
+    }
+    timerfd_settime(timerFd, 0, &spec, nullptr);
+    MothershipMetrics::Instance().SetGauge("ui.tick_ms", static_cast<double>(interval.count()));
+}
+
+void MothershipEventLoop::Post(std::function<void()> completion) {
+    {
+        std::lock_guard<std::mutex> lock(postedMutex);
+        posted.push_back(std::move(completion));
+    }
+    uint64_t one = 1;
+    ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+bool MothershipEventLoop::Wait(Events& events, int timeoutMs) {
+    events = Events();
+    epoll_event ready[8];
+    int count;
+    do {
+        count = epoll_wait(epollFd, ready, 8, timeoutMs);
+    } while (count < 0 && errno == EINTR);
+    if (count < 0) {
+        return false;
+    }
+    wakeups += 1;
+    MothershipMetrics::Instance().Increment("ui.wakeups");
+
+    for (int i = 0; i < count; ++i) {
+        int fd = ready[i].data.fd;
+        if (fd == inputFd) {
+            events.input = true;
+            events.inputAt = std::chrono::steady_clock::now();
+        } else if (fd == timerFd) {
+            uint64_t expirations = 0;
+            if (::read(timerFd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+                events.tick = true;
+                events.ticks += expirations;
+            }
+        } else if (fd == signalFd) {
+            signalfd_siginfo info;
+            while (::read(signalFd, &info, sizeof(info)) == sizeof(info)) {
+                if (info.ssi_signo == SIGWINCH) {
+                    events.resize = true;
+                } else {
+                    events.quit = true;
+                }
+            }
+        } else if (fd == wakeFd) {
+            uint64_t value = 0;
+            ssize_t ignored = ::read(wakeFd, &value, sizeof(value));
+            (void)ignored;
+            std::deque<std::function<void()>> batch;
+            {
+                std::lock_guard<std::mutex> lock(postedMutex);
+                batch.swap(posted);
+            }
+            for (auto& completion : batch) {
+                completion();
+            }
+            events.completions += batch.size();
+        }
+    }
+    return true;
+}
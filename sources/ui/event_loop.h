@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+// epoll-based main loop. Multiplexes terminal input, a timerfd for display
+// ticks, a signalfd (SIGINT, SIGTERM, SIGWINCH) and an eventfd on which
+// background work posts its completions. With no tick armed and no input
+// the process sleeps in epoll_wait without any wakeups.
+class MothershipEventLoop {
+public:
+    struct Events {
+        bool input = false;
+        bool tick = false;
+        bool resize = false;
+        bool quit = false;
+        // Timer expirations since the last Wait, >1 if ticks were missed.
+        unsigned long long ticks = 0;
+        // Completions run during this Wait.
+        size_t completions = 0;
+        // When input was seen readable; the start of input-to-photon latency.
+        std::chrono::steady_clock::time_point inputAt;
+    };
+
+    MothershipEventLoop() = default;
+    ~MothershipEventLoop();
+
+    MothershipEventLoop(const MothershipEventLoop&) = delete;
+    MothershipEventLoop& operator=(const MothershipEventLoop&) = delete;
+
+    // Blocks the handled signals for the process and creates the fds.
+    bool Init();
+    bool WatchInput(int fd);
+
+    // Arms a periodic tick; zero disarms it. When aligned, the first tick
+    // lands on the next multiple of `interval` of the wall clock so that a
+    // 1 s tick flips the seconds digit on time.
+    void SetTick(std::chrono::milliseconds interval, bool aligned = true);
+    inline std::chrono::milliseconds Tick() const {
+        return tickInterval;
+    }
+
+    // Thread safe. `completion` runs on the loop thread inside Wait.
+    void Post(std::function<void()> completion);
+
+    // Waits for at least one event (or the timeout, -1 = forever).
+    bool Wait(Events& events, int timeoutMs = -1);
+
+    inline unsigned long long Wakeups() const {
+        return wakeups;
+    }
+
+private:
+    int epollFd = -1;
+    int timerFd = -1;
+    int signalFd = -1;
+    int wakeFd = -1;
+    int inputFd = -1;
+
+    std::chrono::milliseconds tickInterval{0};
+    unsigned long long wakeups = 0;
+
+    std::mutex postedMutex;
+    std::deque<std::function<void()>> posted;
+};
@@ -0,0 +1,140 @@
+#include "ui/headless_terminal.h"
+
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+#include <pty.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+MothershipHeadlessTerminal::~MothershipHeadlessTerminal() {
+    Close();
+}
+
+bool MothershipHeadlessTerminal::Open(int rows, int cols, const char* type) {
+    Close();
+    winsize size{};
+    size.ws_row = static_cast<unsigned short>(rows);
+    size.ws_col = static_cast<unsigned short>(cols);
+    if (openpty(&master, &slave, nullptr, nullptr, &size) != 0) {
+        master = slave = -1;
+        return false;
+    }
+    fcntl(master, F_SETFD, FD_CLOEXEC);
+    fcntl(slave, F_SETFD, FD_CLOEXEC);
+
+    int inputFd = dup(slave);
+    output = fdopen(slave, "w");
+    input = inputFd >= 0 ? fdopen(inputFd, "r") : nullptr;
+    if (!output || !input) {
+        Close();
+        return false;
+    }
+    drainThread = std::thread([this] { Drain(); });
+
+    screen = newterm(type, output, input);
+    if (!screen) {
+        Close();
+        return false;
+    }
+    set_term(screen);
+    start_color();
+    cbreak();
+    noecho();
+    curs_set(0);
+    keypad(stdscr, TRUE);
+    nodelay(stdscr, TRUE);
+    return true;
+}
+
+void MothershipHeadlessTerminal::Close() {
+    if (screen) {
+        endwin();
+        delscreen(screen);
+        screen = nullptr;
+    }
+    if (output) {
+        fclose(output);
+        output = nullptr;
+    } else if (slave >= 0) {
+        close(slave);
+    }
+    slave = -1;
+    if (input) {
+        fclose(input);
+        input = nullptr;
+    }
+    // With every slave descriptor closed the drain sees EIO and returns.
+    if (drainThread.joinable()) {
+        drainThread.join();
+    }
+    if (master >= 0) {
+        close(master);
+        master = -1;
+    }
+}
+
+bool MothershipHeadlessTerminal::Resize(int rows, int cols) {
+    if (!screen) {
+        return false;
+    }
+    winsize size{};
+    size.ws_row = static_cast<unsigned short>(rows);
+    size.ws_col = static_cast<unsigned short>(cols);
+    if (ioctl(slave, TIOCSWINSZ, &size) != 0) {
+        return false;
+    }
+    return resizeterm(rows, cols) == OK;
+}
+
+bool MothershipHeadlessTerminal::Type(const std::string& keys) {
+    if (!screen) {
+        return false;
+    }
+    for (size_t written = 0; written < keys.size();) {
+        ssize_t n = write(master, keys.data() + written, keys.size() - written);
+        if (n < 0 && errno != EINTR) {
+            return false;
+        }
+        written += n > 0 ? static_cast<size_t>(n) : 0;
+    }
+    // The pty hands input over asynchronously.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    int pending = 0;
+    while (ioctl(slave, FIONREAD, &pending) == 0 && static_cast<size_t>(pending) < keys.size()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    return true;
+}
+
+void MothershipHeadlessTerminal::Settle() {
+    if (!output) {
+        return;
+    }
+    fflush(output);
+    tcdrain(slave);
+    int pending = 0;
+    while (ioctl(master, FIONREAD, &pending) == 0 && pending > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    // The last read may still be on its way into the counter.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void MothershipHeadlessTerminal::Drain() {
+    char buffer[16384];
+    while (true) {
+        ssize_t n = read(master, buffer, sizeof(buffer));
+        if (n > 0) {
+            bytes.fetch_add(n, std::memory_order_relaxed);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdio>
+#include <ncurses.h>
+#include <string>
+#include <thread>
+
+// An ncurses screen on a pseudo-terminal instead of the real TTY. The
+// master side is drained by a background thread that only counts bytes,
+// so the UI can be driven and measured without a terminal (benchmarks,
+// CI). While open, the headless screen is the current ncurses screen.
+class MothershipHeadlessTerminal {
+public:
+    MothershipHeadlessTerminal() = default;
+    ~MothershipHeadlessTerminal();
+
+    MothershipHeadlessTerminal(const MothershipHeadlessTerminal&) = delete;
+    MothershipHeadlessTerminal& operator=(const MothershipHeadlessTerminal&) = delete;
+
+    // Creates the pty and the screen with the same modes main() uses.
+    bool Open(int rows, int cols, const char* type = "xterm-256color");
+    void Close();
+    // Changes the pty's window size and tells ncurses about it.
+    bool Resize(int rows, int cols);
+    // Sends `keys` to the screen as if typed, and waits until they can be
+    // read with getch().
+    bool Type(const std::string& keys);
+
+    // Bytes the terminal has received so far. The drain runs concurrently;
+    // call Settle() first for an exact figure.
+    inline long long BytesEmitted() const {
+        return bytes.load(std::memory_order_relaxed);
+    }
+    // Waits until everything written so far has been drained.
+    void Settle();
+
+    inline bool IsOpen() const {
+        return screen != nullptr;
+    }
+
+private:
+    void Drain();
+
+    int master = -1;
+    int slave = -1;
+    FILE* output = nullptr;
+    FILE* input = nullptr;
+    SCREEN* screen = nullptr;
+    std::thread drainThread;
+    std::atomic<long long> bytes{0};
+};
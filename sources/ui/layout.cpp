@@ -0,0 +1,41 @@
+#include "ui/layout.h"
+
+namespace {
+
+const int minFullRows = 12;
+const int minFullCols = 40;
+const int commandHeight = 6;
+
+} // namespace
+
+MothershipLayout MothershipComputeLayout(int rows, int cols) {
+    MothershipLayout layout;
+    if (rows <= 0 || cols <= 0) {
+        layout.compact = true;
+        return layout;
+    }
+
+    if (rows < minFullRows || cols < minFullCols) {
+        layout.compact = true;
+        // Command line plus, when there is room, the status line.
+        int bottom = rows >= 4 ? 2 : 1;
+        layout.command = {rows - bottom, 0, bottom, cols};
+        layout.commandContent = {0, 0, bottom, cols};
+        if (rows > bottom) {
+            layout.tasks = {0, 0, rows - bottom, cols};
+            layout.tasksContent = {0, 0, rows - bottom, cols};
+        }
+        return layout;
+    }
+
+    int topHeight = rows - commandHeight;
+    int halfX = cols / 2;
+    layout.tasks = {0, 0, topHeight, halfX};
+    layout.progress = {0, halfX, topHeight, cols - halfX};
+    layout.command = {topHeight, 0, commandHeight, cols};
+    // Inside the border, below the title.
+    layout.tasksContent = {3, 2, topHeight - 4, halfX - 4};
+    layout.progressContent = {3, 2, topHeight - 4, cols - halfX - 4};
+    layout.commandContent = {2, 2, commandHeight - 3, cols - 4};
+    return layout;
+}
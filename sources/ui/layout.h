@@ -0,0 +1,36 @@
+#pragma once
+
+// Screen rectangle in rows and columns. An empty rectangle is a hidden pane.
+struct MothershipRect {
+    int top = 0;
+    int left = 0;
+    int height = 0;
+    int width = 0;
+
+    inline bool Empty() const {
+        return height <= 0 || width <= 0;
+    }
+    bool operator==(const MothershipRect& other) const = default;
+};
+
+// Geometry of the three panels. Window rectangles are in screen
+// coordinates; content rectangles (where the widgets go) are relative to
+// their window.
+//
+// The full layout puts Tasks Regime and Current Progress side by side over
+// the Command panel. Below 12 rows or 40 columns it degrades to a compact
+// single pane: the task list without borders over a bare command and
+// status line, with the progress panel hidden.
+struct MothershipLayout {
+    bool compact = false;
+    MothershipRect tasks;
+    MothershipRect progress;
+    MothershipRect command;
+    MothershipRect tasksContent;
+    MothershipRect progressContent;
+    MothershipRect commandContent;
+
+    bool operator==(const MothershipLayout& other) const = default;
+};
+
+MothershipLayout MothershipComputeLayout(int rows, int cols);
@@ -0,0 +1,86 @@
+#include "ui/list_view.h"
+
+#include <algorithm>
+
+void MothershipListView::Clamp() {
+    if (count == 0) {
+        top = selected = 0;
+        return;
+    }
+    selected = std::min(selected, count - 1);
+    size_t visible = static_cast<size_t>(std::max(1, height));
+    size_t maxTop = count > visible ? count - visible : 0;
+    top = std::min(top, maxTop);
+}
+
+void MothershipListView::SetCount(size_t count) {
+    this->count = count;
+    Clamp();
+}
+
+void MothershipListView::SetHeight(int height) {
+    this->height = std::max(0, height);
+    Clamp();
+    JumpToSelection();
+}
+
+void MothershipListView::Select(size_t index) {
+    selected = index;
+    Clamp();
+    JumpToSelection();
+}
+
+void MothershipListView::MoveSelection(long delta) {
+    if (count == 0) {
+        return;
+    }
+    long target = static_cast<long>(selected) + delta;
+    target = std::clamp(target, 0L, static_cast<long>(count) - 1);
+    Select(static_cast<size_t>(target));
+}
+
+void MothershipListView::PageUp() {
+    MoveSelection(-std::max(1, height - 1));
+}
+
+void MothershipListView::PageDown() {
+    MoveSelection(std::max(1, height - 1));
+}
+
+void MothershipListView::Home() {
+    Select(0);
+}
+
+void MothershipListView::End() {
+    if (count > 0) {
+        Select(count - 1);
+    }
+}
+
+void MothershipListView::JumpToSelection() {
+    if (count == 0 || height <= 0) {
+        return;
+    }
+    if (selected < top) {
+        top = selected;
+    } else if (selected >= top + static_cast<size_t>(height)) {
+        top = selected - static_cast<size_t>(height) + 1;
+    }
+}
+
+void MothershipListView::Render(MothershipWidget& widget, const _RowFormatter& formatter) const {
+    int row = 0;
+    for (; row < widget.Height() && top + row < count; ++row) {
+        size_t index = top + static_cast<size_t>(row);
+        attr_t attr = A_NORMAL;
+        short pair = 0;
+        text.clear();
+        formatter(index, text, attr, pair);
+        if (index == selected) {
+            attr |= A_REVERSE;
+            text.resize(static_cast<size_t>(widget.Width()), ' ');
+        }
+        widget.SetRow(row, text, attr, pair);
+    }
+    widget.ClearRows(row);
+}
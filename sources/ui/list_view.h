@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "ui/render_model.h"
+
+// Virtualized list: keeps a window [top, top + height) over `count` rows
+// and a selection. Scrolling, paging and jumping are index arithmetic and
+// Render formats only the visible rows, so cost is independent of count.
+class MothershipListView {
+public:
+    // Formats row `index` into `text`; sets `attr`/`pair` as desired.
+    typedef std::function<void(size_t index, std::string& text, attr_t& attr, short& pair)> _RowFormatter;
+
+    void SetCount(size_t count);
+    void SetHeight(int height);
+
+    void Select(size_t index);
+    void MoveSelection(long delta);
+    void PageUp();
+    void PageDown();
+    void Home();
+    void End();
+    // Scrolls the minimum needed to bring the selection into view.
+    void JumpToSelection();
+
+    // Draws the visible rows; the selection is shown in reverse video.
+    void Render(MothershipWidget& widget, const _RowFormatter& formatter) const;
+
+    inline size_t Count() const {
+        return count;
+    }
+    inline size_t Top() const {
+        return top;
+    }
+    inline size_t Selected() const {
+        return selected;
+    }
+    inline bool Empty() const {
+        return count == 0;
+    }
+
+private:
+    void Clamp();
+
+    size_t count = 0;
+    size_t top = 0;
+    size_t selected = 0;
+    int height = 0;
+    // Row text, kept between frames so formatting a row does not allocate.
+    mutable std::string text;
+};
@@ -0,0 +1,249 @@
+#include "ui/mothership_ui.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "metrics.h"
+#include "ui/text_format.h"
+
+namespace {
+
+// Pairs 1-4 are the chrome colors; task colors are allocated after them.
+const int chromePairs = 4;
+
+const int keyFocusIn = KEY_MAX + 1;
+const int keyFocusOut = KEY_MAX + 2;
+
+} // namespace
+
+MothershipUi::MothershipUi(MothershipData& data) : data(data) {
+
+}
+
+MothershipUi::~MothershipUi() {
+    DestroyWindows();
+}
+
+void MothershipUi::DestroyWindows() {
+    for (WINDOW** window : {&leftWin, &rightWin, &bottomWin}) {
+        if (*window) {
+            delwin(*window);
+            *window = nullptr;
+        }
+    }
+}
+
+void MothershipUi::Start(int maxY, int maxX) {
+    init_pair(1, COLOR_WHITE, COLOR_BLACK);
+    init_pair(2, COLOR_RED, COLOR_BLACK);
+    init_pair(3, COLOR_GREEN, COLOR_BLACK);
+    init_pair(4, COLOR_CYAN, COLOR_BLACK);
+
+    if (profile.lowBandwidth) {
+        // Focus in/out reports; see MothershipFocusReports.
+        define_key("\033[I", keyFocusIn);
+        define_key("\033[O", keyFocusOut);
+    }
+
+    progressChart.SetUnicode(!profile.lowBandwidth && MothershipUnicodeTerminal());
+    colorManager.Init(chromePairs);
+    renderModel.SetColorManager(&colorManager);
+    renderModel.Add(&taskListWidget);
+    renderModel.Add(&progressWidget);
+    renderModel.Add(&commandWidget);
+
+    InitializeWindows(maxY, maxX);
+}
+
+bool MothershipUi::PlaceWindow(WINDOW*& window, const MothershipRect& current, const MothershipRect& wanted) {
+    // Hidden panes keep a 1x1 window that is never refreshed.
+    int height = std::max(1, wanted.height);
+    int width = std::max(1, wanted.width);
+    if (!window) {
+        window = newwin(height, width, wanted.top, wanted.left);
+        return true;
+    }
+    if (current == wanted) {
+        return false;
+    }
+    // Resize first: the new size always fits at the new position.
+    wresize(window, height, width);
+    mvwin(window, wanted.top, wanted.left);
+    return true;
+}
+
+void MothershipUi::InitializeWindows(int maxY, int maxX) {
+    MothershipLayout wanted = MothershipComputeLayout(maxY, maxX);
+    bool modeChanged = wanted.compact != layout.compact;
+
+    bool tasksChanged = PlaceWindow(leftWin, layout.tasks, wanted.tasks) || modeChanged;
+    bool progressChanged = PlaceWindow(rightWin, layout.progress, wanted.progress) || modeChanged;
+    bool commandChanged = PlaceWindow(bottomWin, layout.command, wanted.command) || modeChanged;
+    layout = wanted;
+
+    // Clearing a window loses its widget's cells, so only those panes are
+    // placed (and therefore redrawn) again.
+    if (tasksChanged) {
+        DrawChrome(leftWin, layout.tasks.Empty() ? nullptr : "Tasks Regime");
+        const MothershipRect& r = layout.tasksContent;
+        taskListWidget.Place(leftWin, r.top, r.left, r.height, r.width);
+        taskListView.SetHeight(taskListWidget.Height());
+        searchView.SetHeight(taskListWidget.Height());
+    }
+    if (progressChanged) {
+        DrawChrome(rightWin, layout.progress.Empty() ? nullptr : "Current Progress");
+        const MothershipRect& r = layout.progressContent;
+        progressWidget.Place(rightWin, r.top, r.left, r.height, r.width);
+    }
+    if (commandChanged) {
+        DrawChrome(bottomWin, "Command");
+        const MothershipRect& r = layout.commandContent;
+        commandWidget.Place(bottomWin, r.top, r.left, r.height, r.width);
+    }
+    if (tasksChanged || progressChanged || commandChanged) {
+        static auto& relayouts = MothershipMetrics::Instance().Counter("ui.relayouts");
+        relayouts.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Everything that does not change between frames: background, border and
+// title. Drawn once per layout, not per frame. A null title marks a hidden
+// pane, which is left alone; compact panes get no border.
+void MothershipUi::DrawChrome(WINDOW* window, const char* title) {
+    if (!title) {
+        return;
+    }
+    // Paint entire windows with background color
+    wbkgd(window, COLOR_PAIR(Pair(1)));
+    werase(window);
+
+    if (!layout.compact) {
+        if (profile.lowBandwidth) {
+            wborder(window, '|', '|', '-', '-', '+', '+', '+', '+');
+            mvwprintw(window, 1, 2, "%s", title);
+        } else {
+            box(window, 0, 0);
+            wattron(window, A_BOLD);
+            mvwprintw(window, 1, 2, "%s", title);
+            wattroff(window, A_BOLD);
+        }
+    }
+
+    renderModel.Touch(window);
+}
+
+// Refreshes the widgets' retained content and sends what changed to the
+// terminal. Unchanged cells cost nothing, so calling this every tick only
+// emits the timer digits that moved.
+void MothershipUi::OutputToWindows() {
+    char line[256];
+
+    auto formatTask = [&](MothershipTask& task, std::string& text, short& pair) {
+        pair = profile.lowBandwidth ? 0 : colorManager.Pair(task.color);
+        size_t length = 0;
+        line[length++] = task.Started() ? '>' : ' ';
+        line[length++] = ' ';
+        // One byte is kept for the space after the title.
+        length += MothershipFormatColumns(line + length, sizeof(line) - length - 1, task.title, 20);
+        line[length++] = ' ';
+        length += MothershipFormatClock(line + length, sizeof(line) - length, task.TotalTime(), ShowSeconds());
+        text.assign(line, length);
+    };
+
+    // Only the visible slice of the task list (or of the matches) is formatted.
+    bool searching = Searching();
+    if (searching) {
+        titleSearch.Update(data, commandLine.substr(1));
+        searchView.SetCount(titleSearch.Count());
+        searchView.Render(taskListWidget, [&](size_t index, std::string& text, attr_t&, short& pair) {
+            formatTask(*titleSearch.At(index), text, pair);
+        });
+    } else {
+        taskListView.SetCount(data.TaskCount());
+        taskListView.Render(taskListWidget, [&](size_t index, std::string& text, attr_t&, short& pair) {
+            formatTask(data.TaskAt(index), text, pair);
+        });
+    }
+
+    progressChart.Render(data, progressWidget, ShowSeconds(), Pair(3));
+
+    commandWidget.SetRow(0, "> " + commandLine);
+    if (searching) {
+        std::snprintf(line, sizeof(line), "%zu matches", titleSearch.Count());
+        commandWidget.SetRow(1, line, A_NORMAL, Pair(4));
+    } else {
+        commandWidget.SetRow(1, statusLine, A_NORMAL, Pair(4));
+    }
+
+    renderModel.Frame();
+}
+
+MothershipInputBatch MothershipUi::HandleInput() {
+    MothershipInputBatch batch;
+    int ch;
+    while (!batch.quit && (ch = getch()) != ERR) {
+        batch.keys += 1;
+        MothershipCommandResult result = HandleKey(ch);
+        if (result == CommandQuit) {
+            batch.quit = true;
+        } else if (result == CommandChanged) {
+            batch.changed = true;
+        }
+    }
+    return batch;
+}
+
+MothershipCommandResult MothershipUi::HandleKey(int ch) {
+    if (ch == '\n' || ch == '\r' || ch == KEY_ENTER) {
+        std::string line = commandLine;
+        commandLine.clear();
+        if (!line.empty() && line[0] == '/') {
+            SelectMatch(line.substr(1));
+            return CommandIgnored;
+        }
+        if (line == "seconds") {
+            showSeconds = !showSeconds;
+            return CommandIgnored;
+        }
+        return ExecuteCommand(data, line, statusLine);
+    } else if (ch == KEY_BACKSPACE || ch == 127 || ch == 8) {
+        if (!commandLine.empty()) {
+            commandLine.pop_back();
+        }
+    } else if (ch == 27) {
+        commandLine.clear();
+    } else if (ch == KEY_UP) {
+        ActiveListView().MoveSelection(-1);
+    } else if (ch == KEY_DOWN) {
+        ActiveListView().MoveSelection(1);
+    } else if (ch == KEY_PPAGE) {
+        ActiveListView().PageUp();
+    } else if (ch == KEY_NPAGE) {
+        ActiveListView().PageDown();
+    } else if (ch == KEY_HOME) {
+        ActiveListView().Home();
+    } else if (ch == KEY_END) {
+        ActiveListView().End();
+    } else if (ch == keyFocusIn || ch == keyFocusOut) {
+        focused = ch == keyFocusIn;
+    } else if (ch == KEY_RESIZE) {
+        InitializeWindows(LINES, COLS);
+    } else if (ch >= 32 && ch < 127) {
+        commandLine.push_back(static_cast<char>(ch));
+    }
+    return CommandIgnored;
+}
+
+void MothershipUi::SelectMatch(const std::string& query) {
+    titleSearch.Update(data, query);
+    if (titleSearch.Count() == 0) {
+        statusLine = "no task matches " + query;
+    } else {
+        MothershipTask* task = titleSearch.At(std::min(searchView.Selected(), titleSearch.Count() - 1));
+        taskListView.SetCount(data.TaskCount());
+        taskListView.Select(static_cast<size_t>(data.IndexOf(task->title)));
+        statusLine = task->title;
+    }
+    titleSearch.Clear();
+    searchView.Home();
+}
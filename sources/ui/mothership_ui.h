@@ -0,0 +1,119 @@
+#pragma once
+
+#include <chrono>
+#include <ncurses.h>
+#include <string>
+
+#include "commands.h"
+#include "mothership_data.h"
+#include "title_search.h"
+#include "ui/color_manager.h"
+#include "ui/layout.h"
+#include "ui/list_view.h"
+#include "ui/progress_chart.h"
+#include "ui/render_profile.h"
+#include "ui/render_model.h"
+
+// What one call to MothershipUi::HandleInput applied.
+struct MothershipInputBatch {
+    size_t keys = 0;
+    // Some command changed the data: save once for the whole batch.
+    bool changed = false;
+    bool quit = false;
+};
+
+// The three panels (Tasks Regime, Current Progress, Command) over one
+// MothershipData. Draws onto whatever ncurses screen is current, so the
+// same code runs on the real terminal and on a headless one.
+class MothershipUi {
+public:
+    explicit MothershipUi(MothershipData& data);
+    ~MothershipUi();
+
+    MothershipUi(const MothershipUi&) = delete;
+    MothershipUi& operator=(const MothershipUi&) = delete;
+
+    // Takes effect at Start.
+    inline void SetProfile(const MothershipRenderProfile& profile) {
+        this->profile = profile;
+    }
+    // Sets up colors, widgets and windows for a maxY x maxX screen.
+    void Start(int maxY, int maxX);
+    // Creates the windows on the first call. Afterwards moves and resizes
+    // them in place for the new screen size; only panes whose geometry
+    // changed are cleared and redrawn.
+    void InitializeWindows(int maxY, int maxX);
+    // Refreshes the widgets and sends what changed to the terminal.
+    void OutputToWindows();
+    // Applies one key. Commands typed into the Command panel are executed;
+    // the result tells the caller whether to save or quit. A line starting
+    // with '/' searches titles as it is typed: the task list shows only the
+    // matches and Enter selects the highlighted one in the full list.
+    MothershipCommandResult HandleKey(int ch);
+    // Applies every key the current screen has buffered, until getch()
+    // returns ERR or a command quits, as one batch: the caller draws one
+    // frame and saves at most once however many keys were typed or pasted.
+    MothershipInputBatch HandleInput();
+
+    inline void SetStatus(const std::string& status) {
+        statusLine = status;
+    }
+    // Seconds are shown when enabled and, in the low-bandwidth profile,
+    // only while the terminal has focus.
+    inline bool ShowSeconds() const {
+        return showSeconds && (!profile.lowBandwidth || focused);
+    }
+    inline const MothershipRenderProfile& Profile() const {
+        return profile;
+    }
+    inline MothershipRenderModel& RenderModel() {
+        return renderModel;
+    }
+    inline MothershipListView& TaskListView() {
+        return taskListView;
+    }
+    inline const MothershipLayout& Layout() const {
+        return layout;
+    }
+
+private:
+    // Returns true if the window was created, moved or resized.
+    bool PlaceWindow(WINDOW*& window, const MothershipRect& current, const MothershipRect& wanted);
+    void DrawChrome(WINDOW* window, const char* title);
+    void DestroyWindows();
+    inline bool Searching() const {
+        return commandLine.size() > 1 && commandLine[0] == '/';
+    }
+    inline MothershipListView& ActiveListView() {
+        return Searching() ? searchView : taskListView;
+    }
+    void SelectMatch(const std::string& query);
+    // Chrome color pair, or the default pair in the low-bandwidth profile.
+    inline short Pair(short pair) const {
+        return profile.lowBandwidth ? 0 : pair;
+    }
+
+    MothershipData& data;
+    MothershipLayout layout;
+    MothershipRenderProfile profile;
+
+    WINDOW* leftWin = nullptr;
+    WINDOW* rightWin = nullptr;
+    WINDOW* bottomWin = nullptr;
+
+    MothershipColorManager colorManager;
+    MothershipRenderModel renderModel;
+    MothershipWidget taskListWidget;
+    MothershipWidget progressWidget;
+    MothershipProgressChart progressChart;
+    MothershipWidget commandWidget;
+    MothershipListView taskListView;
+    MothershipListView searchView;
+    MothershipTitleSearch titleSearch;
+
+    std::string commandLine;
+    std::string statusLine;
+    bool showSeconds = true;
+    // Until the terminal reports focus, assume it has none.
+    bool focused = false;
+};
@@ -0,0 +1,282 @@
+#include "ui/progress_chart.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <langinfo.h>
+
+#include "reports/civil_time.h"
+#include "ui/mothership_ui.h"
+#include "ui/text_format.h"
+
+namespace {
+
+typedef std::chrono::system_clock::time_point TimePoint;
+
+TimePoint LocalMidnight(TimePoint now) {
+    return MothershipTimeZone::Local().DayStart(now);
+}
+
+TimePoint NextLocalMidnight(TimePoint midnight) {
+    return MothershipTimeZone::Local().DayStart(midnight, 1);
+}
+
+// UTF-8 for U+0000-U+FFFF.
+void AppendUtf8(std::string& out, uint32_t ch) {
+    if (ch < 0x80) {
+        out.push_back(static_cast<char>(ch));
+    } else if (ch < 0x800) {
+        out.push_back(static_cast<char>(0xc0 | (ch >> 6)));
+        out.push_back(static_cast<char>(0x80 | (ch & 0x3f)));
+    } else {
+        out.push_back(static_cast<char>(0xe0 | (ch >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3f)));
+        out.push_back(static_cast<char>(0x80 | (ch & 0x3f)));
+    }
+}
+
+} // namespace
+
+bool MothershipUnicodeTerminal() {
+    const char* codeset = nl_langinfo(CODESET);
+    return codeset && (!std::strcmp(codeset, "UTF-8") || !std::strcmp(codeset, "utf8"));
+}
+
+void MothershipTodayAggregate::Add(const MothershipTask* task, TimePoint from, TimePoint to) {
+    from = std::max(from, dayStart);
+    to = std::min(to, dayEnd);
+    if (to <= from) {
+        return;
+    }
+    auto [it, inserted] = taskTime.try_emplace(task, MothershipDuration(0));
+    it->second += MothershipDuration(MothershipTicks(to) - MothershipTicks(from));
+    if (inserted) {
+        identities.emplace(task, Identity{task->title, task->stamp});
+    }
+    // Spread over the minutes touched; O(minutes spanned).
+    double offset = std::chrono::duration<double>(from - dayStart).count();
+    double end = std::chrono::duration<double>(to - dayStart).count();
+    while (offset < end) {
+        int minute = std::min(static_cast<int>(offset / 60.0), minutesPerDay - 1);
+        double boundary = std::min(end, (minute + 1) * 60.0);
+        minutes[minute] += static_cast<float>(boundary - offset);
+        offset = boundary;
+    }
+}
+
+void MothershipTodayAggregate::Count(MothershipTask& task, TimePoint now) {
+    // Timeframes are kept in start order: walk back until before today.
+    for (auto it = task.timeFrames.rbegin(); it != task.timeFrames.rend(); ++it) {
+        SingleTimeframe& timeframe = it->second;
+        if (timeframe.Started()) {
+            Add(&task, timeframe.startTime, now);
+            live[&task] = Live{it->first, now};
+        } else if (timeframe.finished) {
+            if (timeframe.endTime <= dayStart) {
+                break;
+            }
+            Add(&task, timeframe.startTime, timeframe.endTime);
+        }
+    }
+}
+
+void MothershipTodayAggregate::Recount(const std::vector<MothershipTask*>& tasks, TimePoint now) {
+    taskTime.clear();
+    identities.clear();
+    live.clear();
+    minutes.fill(0.0f);
+    for (MothershipTask* task : tasks) {
+        Count(*task, now);
+    }
+}
+
+void MothershipTodayAggregate::Rebuild(MothershipData& data, TimePoint now) {
+    dayStart = LocalMidnight(now);
+    dayEnd = NextLocalMidnight(dayStart);
+    generation = data.IndexGeneration();
+    reloads = data.ReloadGeneration();
+    taskTime.clear();
+    identities.clear();
+    live.clear();
+    minutes.fill(0.0f);
+    for (auto& [title, task] : data.tasks) {
+        Count(task, now);
+    }
+    built = true;
+}
+
+bool MothershipTodayAggregate::Advance(MothershipData& data, TimePoint now) {
+    if (!built || reloads != data.ReloadGeneration() || now >= dayEnd || now < dayStart) {
+        Rebuild(data, now);
+        return true;
+    }
+    bool changed = false;
+    if (generation != data.IndexGeneration()) {
+        // Tasks were added or erased. Recount the ones with time today that
+        // are still there, and the running ones; nothing else has any.
+        generation = data.IndexGeneration();
+        std::vector<MothershipTask*> kept(data.RunningTasks().begin(), data.RunningTasks().end());
+        for (auto& [task, identity] : identities) {
+            auto it = data.tasks.find(identity.title);
+            if (it != data.tasks.end() && &it->second == task && it->second.stamp == identity.stamp) {
+                kept.push_back(&it->second);
+            }
+        }
+        std::sort(kept.begin(), kept.end());
+        kept.erase(std::unique(kept.begin(), kept.end()), kept.end());
+        Recount(kept, now);
+        changed = true;
+    }
+    const MothershipData::_TaskIndex& running = data.RunningTasks();
+
+    // Close sessions that stopped (or were replaced by a new one) since the last call.
+    for (auto it = live.begin(); it != live.end();) {
+        MothershipTask* task = it->first;
+        bool stillRunning = task->currentTimeframe == it->second.timeframe && task->Started();
+        if (stillRunning) {
+            ++it;
+            continue;
+        }
+        auto timeframe = task->timeFrames.find(it->second.timeframe);
+        if (timeframe != task->timeFrames.end() && timeframe->second.finished) {
+            Add(task, it->second.accounted, timeframe->second.endTime);
+        }
+        it = live.erase(it);
+        changed = true;
+    }
+    for (MothershipTask* task : running) {
+        auto timeframe = task->timeFrames.find(task->currentTimeframe);
+        if (timeframe == task->timeFrames.end() || !timeframe->second.Started()) {
+            continue;
+        }
+        auto [it, inserted] = live.try_emplace(task, Live{task->currentTimeframe, timeframe->second.startTime});
+        if (inserted) {
+            changed = true;
+        }
+        Add(task, it->second.accounted, now);
+        it->second.accounted = std::max(it->second.accounted, now);
+    }
+    return changed;
+}
+
+void MothershipProgressChart::Reorder(MothershipData& data) {
+    rows.clear();
+    finishedMax = MothershipDuration(0);
+    for (MothershipTask* task : data.RunningTasks()) {
+        rows.push_back(task);
+    }
+    size_t runningCount = rows.size();
+    for (auto& [task, time] : today.Tasks()) {
+        MothershipTask* mutableTask = const_cast<MothershipTask*>(task);
+        if (!mutableTask->Started()) {
+            rows.push_back(mutableTask);
+        }
+        finishedMax = std::max(finishedMax, time);
+    }
+    std::sort(rows.begin() + runningCount, rows.end(), [&](const MothershipTask* a, const MothershipTask* b) {
+        MothershipDuration ta = today.TaskTime(a);
+        MothershipDuration tb = today.TaskTime(b);
+        return ta != tb ? ta > tb : a->title < b->title;
+    });
+}
+
+std::string MothershipProgressChart::Timeline(int width) const {
+    // Eighth blocks rising from the baseline, by share of the column's time that was active.
+    static const uint32_t levels[] = {' ', 0x2581, 0x2582, 0x2583, 0x2584, 0x2585, 0x2586, 0x2587, 0x2588};
+    static const char ascii[] = " .:-=+*#@";
+    const auto& minutes = today.Minutes();
+    std::string out;
+    for (int col = 0; col < width; ++col) {
+        int from = col * MothershipTodayAggregate::minutesPerDay / width;
+        int to = std::max(from + 1, (col + 1) * MothershipTodayAggregate::minutesPerDay / width);
+        double active = 0.0;
+        for (int m = from; m < to; ++m) {
+            active += minutes[m];
+        }
+        double share = std::min(1.0, active / ((to - from) * 60.0));
+        int level = share <= 0.0 ? 0 : std::max(1, static_cast<int>(std::lround(share * 8)));
+        if (unicode) {
+            AppendUtf8(out, levels[level]);
+        } else {
+            out.push_back(ascii[level]);
+        }
+    }
+    return out;
+}
+
+std::string MothershipProgressChart::Axis(int width) const {
+    std::string out(static_cast<size_t>(std::max(0, width)), ' ');
+    for (int hour = 0; hour < 24; hour += 6) {
+        char label[4];
+        int length = std::snprintf(label, sizeof(label), "%d", hour);
+        int col = hour * width / 24;
+        if (col + length <= width) {
+            out.replace(static_cast<size_t>(col), static_cast<size_t>(length), label);
+        }
+    }
+    return out;
+}
+
+std::string MothershipProgressChart::Bar(double fraction, int width) const {
+    // Left-aligned eighth blocks: a cell is split in eight steps.
+    static const uint32_t partial[] = {0, 0x258f, 0x258e, 0x258d, 0x258c, 0x258b, 0x258a, 0x2589};
+    fraction = std::clamp(fraction, 0.0, 1.0);
+    std::string out;
+    if (unicode) {
+        int eighths = static_cast<int>(fraction * width * 8);
+        for (int i = 0; i < eighths / 8; ++i) {
+            AppendUtf8(out, 0x2588);
+        }
+        if (eighths % 8) {
+            AppendUtf8(out, partial[eighths % 8]);
+        }
+    } else {
+        out.assign(static_cast<size_t>(fraction * width), '#');
+    }
+    return out;
+}
+
+void MothershipProgressChart::Render(MothershipData& data, MothershipWidget& widget, bool withSeconds, short barPair) {
+    auto now = MothershipNow();
+    if (today.Advance(data, now)) {
+        Reorder(data);
+    }
+    int width = widget.Width();
+    if (widget.Height() <= 0 || width <= 0) {
+        return;
+    }
+    widget.SetRow(0, Timeline(width), A_NORMAL, barPair);
+    widget.SetRow(1, Axis(width));
+    widget.SetRow(2, std::string());
+
+    // Whole hours, at least one; only crossing an hour rescales every bar.
+    MothershipDuration longest = finishedMax;
+    for (MothershipTask* task : data.RunningTasks()) {
+        longest = std::max(longest, today.TaskTime(task));
+    }
+    double scale = std::max(1.0, std::ceil(MothershipSeconds(longest) / 3600.0)) * 3600.0;
+
+    char prefix[64];
+    char time[32];
+    int row = 3;
+    for (size_t i = 0; i < rows.size() && row < widget.Height(); ++i, ++row) {
+        MothershipTask* task = rows[i];
+        MothershipDuration spent = today.TaskTime(task);
+        int timeLength = static_cast<int>(MothershipFormatClock(time, sizeof(time), spent, withSeconds));
+        size_t prefixLength = 0;
+        prefix[prefixLength++] = task->Started() ? '>' : ' ';
+        prefix[prefixLength++] = ' ';
+        prefixLength += MothershipFormatColumns(prefix + prefixLength, sizeof(prefix) - prefixLength - 1, task->title, 12);
+        prefix[prefixLength++] = ' ';
+        // In cells, not bytes: the title may hold multi-byte characters.
+        int length = 2 + 12 + 1;
+        int barWidth = width - length - timeLength - 1;
+        widget.SetRow(row, std::string_view(prefix, prefixLength));
+        if (barWidth > 0) {
+            widget.SetSpan(row, length, Bar(MothershipSeconds(spent) / scale, barWidth), A_NORMAL, barPair);
+        }
+        widget.SetSpan(row, width - timeLength, std::string_view(time, static_cast<size_t>(timeLength)));
+    }
+    widget.ClearRows(row);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mothership_data.h"
+#include "ui/render_model.h"
+
+// Time spent today, per task and per minute of the local day.
+//
+// Built from the history once per day (or after a load or merge), then
+// kept current incrementally. Each Advance() adds only the time that
+// running sessions accrued since the previous one, and it closes the
+// sessions that stopped since then. That costs O(running tasks) per call,
+// independent of the history. Added tasks have no time yet and come in
+// once they run; erasing a task recounts only the tasks with time today.
+class MothershipTodayAggregate {
+public:
+    typedef MothershipTimePoint TimePoint;
+    static const int minutesPerDay = 24 * 60;
+
+    // Returns true if the set of tasks with time today (or their order) may
+    // have changed.
+    bool Advance(MothershipData& data, TimePoint now);
+
+    inline MothershipDuration TaskTime(const MothershipTask* task) const {
+        auto it = taskTime.find(task);
+        return it == taskTime.end() ? MothershipDuration(0) : it->second;
+    }
+    // Active seconds per minute of the day; can exceed 60 with overlapping sessions.
+    inline const std::array<float, minutesPerDay>& Minutes() const {
+        return minutes;
+    }
+    inline const std::unordered_map<const MothershipTask*, MothershipDuration>& Tasks() const {
+        return taskTime;
+    }
+    inline TimePoint DayStart() const {
+        return dayStart;
+    }
+
+private:
+    struct Live {
+        int timeframe;
+        TimePoint accounted; // time up to which the session has been added
+    };
+    // Enough to tell whether a task is still the same one after erasures,
+    // without touching it.
+    struct Identity {
+        std::string title;
+        MothershipStamp stamp;
+    };
+
+    void Rebuild(MothershipData& data, TimePoint now);
+    // Recounts today from `tasks` only.
+    void Recount(const std::vector<MothershipTask*>& tasks, TimePoint now);
+    void Count(MothershipTask& task, TimePoint now);
+    void Add(const MothershipTask* task, TimePoint from, TimePoint to);
+
+    TimePoint dayStart;
+    TimePoint dayEnd;
+    unsigned long long generation = 0;
+    unsigned long long reloads = 0;
+    bool built = false;
+    std::unordered_map<const MothershipTask*, MothershipDuration> taskTime;
+    std::unordered_map<const MothershipTask*, Identity> identities;
+    std::unordered_map<MothershipTask*, Live> live;
+    std::array<float, minutesPerDay> minutes{};
+};
+
+// The Current Progress panel: a timeline of today, an hour axis, and one
+// bar per task with time today (running tasks first, then the rest by time
+// spent). A frame formats only the visible rows. Bars share a scale rounded
+// up to whole hours, so a tick normally changes only the running tasks'
+// bars, their timers, and the timeline's current column.
+class MothershipProgressChart {
+public:
+    // Unicode block glyphs, or ASCII when the terminal cannot show them.
+    inline void SetUnicode(bool unicode) {
+        this->unicode = unicode;
+    }
+
+    void Render(MothershipData& data, MothershipWidget& widget, bool withSeconds, short barPair);
+
+private:
+    void Reorder(MothershipData& data);
+    std::string Timeline(int width) const;
+    std::string Axis(int width) const;
+    std::string Bar(double fraction, int width) const;
+
+    MothershipTodayAggregate today;
+    bool unicode = true;
+    // Tasks with time today, in display order; rebuilt only when the aggregate says so.
+    std::vector<MothershipTask*> rows;
+    MothershipDuration finishedMax{0};
+};
+
+// True when the C library's locale encodes text as UTF-8.
+bool MothershipUnicodeTerminal();
@@ -0,0 +1,228 @@
+#include "ui/render_model.h"
+
+#include <algorithm>
+
+#include "metrics.h"
+#include "ui/color_manager.h"
+#include "ui/terminal_meter.h"
+
+namespace {
+
+// Next code point of `text` at `i`, advancing `i`. Malformed bytes come
+// out as '?'.
+uint32_t DecodeUtf8(std::string_view text, size_t& i) {
+    unsigned char lead = static_cast<unsigned char>(text[i++]);
+    if (lead < 0x80) {
+        return lead;
+    }
+    int extra = lead >= 0xf0 ? 3 : lead >= 0xe0 ? 2 : lead >= 0xc0 ? 1 : -1;
+    if (extra < 0 || i + extra > text.size()) {
+        return '?';
+    }
+    uint32_t ch = lead & (0x3f >> extra);
+    for (int k = 0; k < extra; ++k) {
+        ch = (ch << 6) | (static_cast<unsigned char>(text[i++]) & 0x3f);
+    }
+    return ch;
+}
+
+} // namespace
+
+void MothershipWidget::Place(WINDOW* window, int top, int left, int height, int width) {
+    this->window = window;
+    this->top = top;
+    this->left = left;
+    this->height = std::max(0, height);
+    this->width = std::max(0, width);
+
+    // Keep what fits of the old content so callers may update incrementally.
+    std::vector<MothershipCell> resized(static_cast<size_t>(this->height) * this->width);
+    int oldHeight = dirtyFirst.empty() ? 0 : static_cast<int>(dirtyFirst.size());
+    int oldWidth = oldHeight > 0 ? static_cast<int>(cells.size()) / oldHeight : 0;
+    for (int row = 0; row < std::min(oldHeight, this->height); ++row) {
+        for (int col = 0; col < std::min(oldWidth, this->width); ++col) {
+            resized[row * this->width + col] = cells[row * oldWidth + col];
+        }
+    }
+    cells = std::move(resized);
+    drawn.assign(cells.size(), MothershipCell());
+    dirtyFirst.assign(this->height, 0);
+    dirtyLast.assign(this->height, 0);
+    Invalidate();
+}
+
+void MothershipWidget::MarkDirty(int row, int fromCol, int toCol) {
+    if (fromCol >= toCol) {
+        return;
+    }
+    if (dirtyFirst[row] >= dirtyLast[row]) {
+        dirtyFirst[row] = fromCol;
+        dirtyLast[row] = toCol;
+    } else {
+        dirtyFirst[row] = std::min(dirtyFirst[row], fromCol);
+        dirtyLast[row] = std::max(dirtyLast[row], toCol);
+    }
+    dirty = true;
+}
+
+int MothershipWidget::SetSpan(int row, int col, std::string_view text, attr_t attr, short pair) {
+    if (row < 0 || row >= height || col >= width) {
+        return col;
+    }
+    MothershipCell* line = &cells[row * width];
+    int first = width;
+    int last = 0;
+    int c = col;
+    for (size_t i = 0; i < text.size() && c < width; ++c) {
+        MothershipCell cell;
+        cell.ch = DecodeUtf8(text, i);
+        cell.attr = attr;
+        cell.pair = pair;
+        if (c >= 0 && line[c] != cell) {
+            line[c] = cell;
+            first = std::min(first, c);
+            last = c + 1;
+        }
+    }
+    MarkDirty(row, first, last);
+    return c;
+}
+
+void MothershipWidget::SetRow(int row, std::string_view text, attr_t attr, short pair) {
+    if (row < 0 || row >= height) {
+        return;
+    }
+    int end = SetSpan(row, 0, text, attr, pair);
+    // Blank the remainder of the row.
+    MothershipCell* line = &cells[row * width];
+    int first = width;
+    int last = 0;
+    for (int c = end; c < width; ++c) {
+        if (line[c] != MothershipCell()) {
+            line[c] = MothershipCell();
+            first = std::min(first, c);
+            last = c + 1;
+        }
+    }
+    MarkDirty(row, first, last);
+}
+
+void MothershipWidget::ClearRows(int fromRow) {
+    for (int row = std::max(0, fromRow); row < height; ++row) {
+        SetRow(row, std::string_view());
+    }
+}
+
+void MothershipWidget::Invalidate() {
+    for (int row = 0; row < height; ++row) {
+        dirtyFirst[row] = 0;
+        dirtyLast[row] = width;
+    }
+    // Mismatch every drawn cell so the comparison in Draw rewrites it.
+    for (MothershipCell& cell : drawn) {
+        cell.ch = 0;
+    }
+    dirty = height > 0 && width > 0;
+}
+
+size_t MothershipWidget::Draw() {
+    if (!dirty || !window) {
+        return 0;
+    }
+    size_t written = 0;
+    for (int row = 0; row < height; ++row) {
+        int first = dirtyFirst[row];
+        int last = dirtyLast[row];
+        if (first >= last) {
+            continue;
+        }
+        dirtyFirst[row] = dirtyLast[row] = 0;
+        const MothershipCell* want = &cells[row * width];
+        MothershipCell* have = &drawn[row * width];
+        for (int col = first; col < last; ++col) {
+            if (want[col] == have[col]) {
+                continue;
+            }
+            // Emit the run of consecutive changed cells with one move.
+            wmove(window, top + row, left + col);
+            while (col < last && want[col] != have[col]) {
+                const MothershipCell& cell = want[col];
+                if (cell.ch < 0x80) {
+                    waddch(window, static_cast<chtype>(cell.ch) | cell.attr | COLOR_PAIR(cell.pair));
+                } else {
+                    wchar_t text[2] = {static_cast<wchar_t>(cell.ch), L'\0'};
+                    cchar_t wide;
+                    setcchar(&wide, text, cell.attr, cell.pair, nullptr);
+                    wadd_wch(window, &wide);
+                }
+                have[col] = want[col];
+                ++written;
+                ++col;
+            }
+        }
+    }
+    dirty = false;
+    return written;
+}
+
+void MothershipRenderModel::Add(MothershipWidget* widget) {
+    widgets.push_back(widget);
+}
+
+void MothershipRenderModel::Touch(WINDOW* window) {
+    if (std::find(touched.begin(), touched.end(), window) == touched.end()) {
+        touched.push_back(window);
+    }
+}
+
+bool MothershipRenderModel::Frame() {
+    if (colors) {
+        colors->Flush();
+    }
+    size_t cellsWritten = 0;
+    for (MothershipWidget* widget : widgets) {
+        if (widget->Dirty()) {
+            cellsWritten += widget->Draw();
+            Touch(widget->Window());
+        }
+    }
+    if (touched.empty()) {
+        lastFrameCells = 0;
+        lastFrameBytes = 0;
+        return false;
+    }
+    for (WINDOW* window : touched) {
+        wnoutrefresh(window);
+    }
+    touched.clear();
+
+    long long before = MothershipThreadBytesWritten();
+    doupdate();
+    long long after = MothershipThreadBytesWritten();
+
+    lastFrameCells = cellsWritten;
+    lastFrameBytes = before >= 0 && after >= before ? after - before : 0;
+    frames += 1;
+
+    static auto& framesMetric = MothershipMetrics::Instance().Counter("ui.frames");
+    static auto& cellsMetric = MothershipMetrics::Instance().Counter("ui.cells_drawn");
+    static auto& bytesMetric = MothershipMetrics::Instance().Counter("ui.bytes_written");
+    static auto& frameBytesMetric = MothershipMetrics::Instance().Gauge("ui.frame_bytes");
+    framesMetric.fetch_add(1, std::memory_order_relaxed);
+    cellsMetric.fetch_add(static_cast<long long>(cellsWritten), std::memory_order_relaxed);
+    bytesMetric.fetch_add(lastFrameBytes, std::memory_order_relaxed);
+    frameBytesMetric.store(static_cast<double>(lastFrameBytes), std::memory_order_relaxed);
+
+    // Average rate since the first frame, for judging slow links.
+    static auto& rateMetric = MothershipMetrics::Instance().Gauge("ui.bytes_per_second");
+    auto now = std::chrono::steady_clock::now();
+    if (frames == 1) {
+        firstFrameAt = now;
+    }
+    totalBytes += lastFrameBytes;
+    double elapsed = std::chrono::duration<double>(now - firstFrameAt).count();
+    if (elapsed > 0.0) {
+        rateMetric.store(static_cast<double>(totalBytes) / elapsed, std::memory_order_relaxed);
+    }
+    return true;
+}
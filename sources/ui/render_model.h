@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ncurses.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class MothershipColorManager;
+
+// One character cell: code point, attributes and color pair. Only
+// single-column characters are supported.
+struct MothershipCell {
+    uint32_t ch = ' ';
+    attr_t attr = A_NORMAL;
+    short pair = 0;
+
+    inline bool operator==(const MothershipCell& other) const {
+        return ch == other.ch && attr == other.attr && pair == other.pair;
+    }
+    inline bool operator!=(const MothershipCell& other) const {
+        return !(*this == other);
+    }
+};
+
+// A rectangle of retained cells inside an ncurses window. Content is set
+// row by row; only cells that differ from what was last drawn are written
+// to the window, and only rows touched since the last Draw are compared.
+class MothershipWidget {
+public:
+    MothershipWidget() = default;
+
+    // (Re)positions the widget; everything is redrawn on the next frame.
+    void Place(WINDOW* window, int top, int left, int height, int width);
+
+    void SetRow(int row, std::string_view text, attr_t attr = A_NORMAL, short pair = 0);
+    // Text is UTF-8. Writes `text` starting at `col` without touching the
+    // rest of the row; returns the column after it.
+    int SetSpan(int row, int col, std::string_view text, attr_t attr = A_NORMAL, short pair = 0);
+    void ClearRows(int fromRow);
+
+    inline bool Dirty() const {
+        return dirty;
+    }
+    inline WINDOW* Window() const {
+        return window;
+    }
+    inline int Height() const {
+        return height;
+    }
+    inline int Width() const {
+        return width;
+    }
+
+    // Forces every cell to be rewritten on the next Draw.
+    void Invalidate();
+    // Writes changed cells into the window. Returns the number written.
+    size_t Draw();
+
+private:
+    void MarkDirty(int row, int fromCol, int toCol);
+
+    WINDOW* window = nullptr;
+    int top = 0;
+    int left = 0;
+    int height = 0;
+    int width = 0;
+
+    std::vector<MothershipCell> cells; // wanted
+    std::vector<MothershipCell> drawn; // in the window
+    // Per row [first, last) column range that may differ; empty when first >= last.
+    std::vector<int> dirtyFirst;
+    std::vector<int> dirtyLast;
+    bool dirty = false;
+};
+
+// Frame composition: draws dirty widgets, stages each touched window with
+// wnoutrefresh and sends everything to the terminal in one doupdate.
+class MothershipRenderModel {
+public:
+    void Add(MothershipWidget* widget);
+    // Windows whose chrome (borders, titles) changed outside the widgets.
+    void Touch(WINDOW* window);
+    // Pairs requested while formatting a frame are defined before it is sent.
+    inline void SetColorManager(MothershipColorManager* colors) {
+        this->colors = colors;
+    }
+
+    // Returns false when there was nothing to draw.
+    bool Frame();
+
+    inline long long LastFrameBytes() const {
+        return lastFrameBytes;
+    }
+    inline size_t LastFrameCells() const {
+        return lastFrameCells;
+    }
+    inline unsigned long long Frames() const {
+        return frames;
+    }
+    inline long long TotalBytes() const {
+        return totalBytes;
+    }
+
+private:
+    std::vector<MothershipWidget*> widgets;
+    std::vector<WINDOW*> touched;
+    MothershipColorManager* colors = nullptr;
+    long long lastFrameBytes = 0;
+    size_t lastFrameCells = 0;
+    unsigned long long frames = 0;
+    long long totalBytes = 0;
+    std::chrono::steady_clock::time_point firstFrameAt;
+};
@@ -0,0 +1,22 @@
+#include "ui/render_profile.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+MothershipRenderProfile MothershipRenderProfile::FromEnvironment() {
+    MothershipRenderProfile profile;
+    if (const char* env = std::getenv("MOTHERSHIP_LOW_BANDWIDTH"); env && *env && std::strcmp(env, "0") != 0) {
+        profile.lowBandwidth = true;
+        profile.maxFps = 4;
+    }
+    if (const char* env = std::getenv("MOTHERSHIP_MAX_FPS"); env && *env) {
+        profile.maxFps = std::max(0, std::atoi(env));
+    }
+    return profile;
+}
+
+void MothershipFocusReports(FILE* output, bool enable) {
+    std::fputs(enable ? "\033[?1004h" : "\033[?1004l", output);
+    std::fflush(output);
+}
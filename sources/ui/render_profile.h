@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdio>
+
+// How the UI trades looks for terminal bandwidth.
+//
+// The low-bandwidth profile is meant for slow or high-latency links (SSH,
+// serial): no colors or bold, ASCII borders instead of line-drawing
+// characters (no charset switches), and timers tick with seconds only
+// while the terminal reports focus. Frames are capped at maxFps; input
+// that arrives in between is folded into the next frame.
+struct MothershipRenderProfile {
+    bool lowBandwidth = false;
+    // 0 leaves the frame rate unlimited.
+    int maxFps = 0;
+
+    // MOTHERSHIP_LOW_BANDWIDTH=1 selects the low-bandwidth profile (4 fps
+    // unless MOTHERSHIP_MAX_FPS says otherwise).
+    static MothershipRenderProfile FromEnvironment();
+};
+
+// Turns xterm focus in/out reports (mode 1004) on or off on `output`. The
+// UI maps the reports to keys so the low-bandwidth profile knows when the
+// terminal is focused; terminals without the mode ignore the request.
+void MothershipFocusReports(FILE* output, bool enable);
@@ -0,0 +1,26 @@
+#include "ui/terminal_meter.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+long long MothershipThreadBytesWritten() {
+    int fd = ::open("/proc/thread-self/io", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    char buffer[512];
+    ssize_t n = ::read(fd, buffer, sizeof(buffer) - 1);
+    ::close(fd);
+    if (n <= 0) {
+        return -1;
+    }
+    buffer[n] = '\0';
+    const char* wchar = std::strstr(buffer, "wchar:");
+    if (!wchar) {
+        return -1;
+    }
+    return std::strtoll(wchar + 6, nullptr, 10);
+}
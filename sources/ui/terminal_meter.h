@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+// Bytes written by the calling thread, from /proc/thread-self/io. The UI
+// thread only writes to the terminal, so the delta across doupdate() is
+// what the terminal received. Returns -1 where the kernel does not
+// provide per-thread I/O accounting.
+long long MothershipThreadBytesWritten();
@@ -0,0 +1,157 @@
+#include "ui/text_format.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+struct DigitPairs {
+    char text[200];
+
+    constexpr DigitPairs() : text() {
+        for (int i = 0; i < 100; ++i) {
+            text[2 * i] = static_cast<char>('0' + i / 10);
+            text[2 * i + 1] = static_cast<char>('0' + i % 10);
+        }
+    }
+};
+
+constexpr DigitPairs digitPairs;
+
+// Formats into a scratch line that always fits, then copies what the
+// caller has room for.
+class Scratch {
+public:
+    inline void Char(char c) {
+        text[length++] = c;
+    }
+    // `value` < 100, always two digits.
+    inline void Two(uint64_t value) {
+        std::memcpy(text + length, digitPairs.text + 2 * value, 2);
+        length += 2;
+    }
+    // At least `minDigits` digits, zero-padded.
+    void Number(uint64_t value, int minDigits) {
+        char digits[20];
+        char* end = digits + sizeof(digits);
+        char* p = end;
+        while (value >= 100) {
+            p -= 2;
+            std::memcpy(p, digitPairs.text + 2 * (value % 100), 2);
+            value /= 100;
+        }
+        if (value >= 10) {
+            p -= 2;
+            std::memcpy(p, digitPairs.text + 2 * value, 2);
+        } else {
+            *--p = static_cast<char>('0' + value);
+        }
+        while (end - p < minDigits) {
+            *--p = '0';
+        }
+        std::memcpy(text + length, p, static_cast<size_t>(end - p));
+        length += static_cast<size_t>(end - p);
+    }
+    inline size_t CopyTo(char* out, size_t size) const {
+        size_t n = std::min(length, size);
+        std::memcpy(out, text, n);
+        return n;
+    }
+
+private:
+    char text[48];
+    size_t length = 0;
+};
+
+inline uint64_t WholeSeconds(MothershipDuration duration) {
+    int64_t seconds = std::chrono::duration_cast<std::chrono::seconds>(duration).count();
+    return seconds > 0 ? static_cast<uint64_t>(seconds) : 0;
+}
+
+} // namespace
+
+size_t MothershipFormatClock(char* out, size_t size, MothershipDuration duration, bool withSeconds) {
+    uint64_t total = WholeSeconds(duration);
+    Scratch line;
+    line.Number(total / 3600, 2);
+    line.Char(':');
+    line.Two(total / 60 % 60);
+    if (withSeconds) {
+        line.Char(':');
+        line.Two(total % 60);
+    }
+    return line.CopyTo(out, size);
+}
+
+size_t MothershipFormatShort(char* out, size_t size, MothershipDuration duration) {
+    uint64_t total = WholeSeconds(duration);
+    Scratch line;
+    if (total >= 3600) {
+        line.Number(total / 3600, 1);
+        line.Char('h');
+        line.Char(' ');
+        line.Two(total / 60 % 60);
+        line.Char('m');
+    } else {
+        line.Number(total / 60, 1);
+        line.Char('m');
+        line.Char(' ');
+        line.Two(total % 60);
+        line.Char('s');
+    }
+    return line.CopyTo(out, size);
+}
+
+size_t MothershipFormatTimestamp(char* out, size_t size, MothershipTimePoint when, const MothershipTimeZone& zone) {
+    int64_t local = zone.ToLocal(MothershipUnixSeconds(when));
+    int64_t days = MothershipFloorDiv(local, 86400);
+    int64_t second = local - days * 86400;
+    MothershipCivilDate date = MothershipCivilFromDays(days);
+    Scratch line;
+    if (date.year < 0) {
+        line.Char('-');
+    }
+    line.Number(static_cast<uint64_t>(date.year < 0 ? -static_cast<int64_t>(date.year) : date.year), 4);
+    line.Char('-');
+    line.Two(static_cast<uint64_t>(date.month));
+    line.Char('-');
+    line.Two(static_cast<uint64_t>(date.day));
+    line.Char(' ');
+    line.Two(static_cast<uint64_t>(second / 3600));
+    line.Char(':');
+    line.Two(static_cast<uint64_t>(second / 60 % 60));
+    line.Char(':');
+    line.Two(static_cast<uint64_t>(second % 60));
+    return line.CopyTo(out, size);
+}
+
+size_t MothershipFormatColumns(char* out, size_t size, std::string_view text, int columns) {
+    size_t written = 0;
+    size_t i = 0;
+    for (int column = 0; column < columns; ++column) {
+        if (i < text.size()) {
+            // One code point: its lead byte and the continuation bytes it
+            // announces, at most four bytes. A stray continuation byte is a
+            // cell of its own.
+            unsigned char lead = static_cast<unsigned char>(text[i]);
+            size_t extra = lead >= 0xf0 ? 3 : lead >= 0xe0 ? 2 : lead >= 0xc0 ? 1 : 0;
+            size_t end = i + 1;
+            while (extra-- > 0 && end < text.size() && (static_cast<unsigned char>(text[end]) & 0xc0) == 0x80) {
+                ++end;
+            }
+            if (written + (end - i) > size) {
+                break;
+            }
+            std::memcpy(out + written, text.data() + i, end - i);
+            written += end - i;
+            i = end;
+        } else {
+            if (written == size) {
+                break;
+            }
+            out[written++] = ' ';
+        }
+    }
+    return written;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "mothership_duration.h"
+#include "reports/civil_time.h"
+
+// Text for the panels, written into caller buffers without allocating.
+// Each writer fills at most `size` bytes of `out` (no terminating NUL) and
+// returns how many it wrote; what does not fit is cut off. Digits come two
+// at a time from a table instead of through printf.
+
+// "HH:MM:SS", or "HH:MM" without seconds; hours get more digits past 99.
+// Negative durations show as zero.
+size_t MothershipFormatClock(char* out, size_t size, MothershipDuration duration, bool withSeconds);
+// "1h 05m" for an hour or more, else "12m 30s".
+size_t MothershipFormatShort(char* out, size_t size, MothershipDuration duration);
+// "YYYY-MM-DD HH:MM:SS" in local time.
+size_t MothershipFormatTimestamp(char* out, size_t size, MothershipTimePoint when,
+                                 const MothershipTimeZone& zone = MothershipTimeZone::Local());
+// `text` (UTF-8) cut or padded with spaces to exactly `columns` cells, one
+// per code point as in MothershipWidget; never splits a character.
+size_t MothershipFormatColumns(char* out, size_t size, std::string_view text, int columns);